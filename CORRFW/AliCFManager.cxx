@@ -21,6 +21,7 @@
 // efficiency calculation.
 // prototype version by S.Arcelli silvia.arcelli@cern.ch
 ///////////////////////////////////////////////////////////////////////////
+#include <algorithm>
 #include "AliCFCutBase.h"
 #include "AliCFManager.h"
 
@@ -34,7 +35,12 @@ AliCFManager::AliCFManager() :
   fEvtContainer(0x0),
   fPartContainer(0x0),
   fEvtCutList(0x0),
-  fPartCutList(0x0)
+  fPartCutList(0x0),
+  fOrderByRejection(kFALSE),
+  fNTrainOrdering(1000),
+  fSelections(),
+  fCompiled(),
+  fCutResults()
 { 
   //
   // ctor
@@ -48,7 +54,12 @@ AliCFManager::AliCFManager(const Char_t* name, const Char_t* title) :
   fEvtContainer(0x0),
   fPartContainer(0x0),
   fEvtCutList(0x0),
-  fPartCutList(0x0)
+  fPartCutList(0x0),
+  fOrderByRejection(kFALSE),
+  fNTrainOrdering(1000),
+  fSelections(),
+  fCompiled(),
+  fCutResults()
 { 
    //
    // ctor
@@ -62,7 +73,12 @@ AliCFManager::AliCFManager(const AliCFManager& c) :
   fEvtContainer(c.fEvtContainer),
   fPartContainer(c.fPartContainer),
   fEvtCutList(c.fEvtCutList),
-  fPartCutList(c.fPartCutList)
+  fPartCutList(c.fPartCutList),
+  fOrderByRejection(c.fOrderByRejection),
+  fNTrainOrdering(c.fNTrainOrdering),
+  fSelections(c.fSelections),
+  fCompiled(c.fCompiled),
+  fCutResults()
 { 
    //
    //copy ctor
@@ -84,6 +100,10 @@ AliCFManager& AliCFManager::operator=(const AliCFManager& c)
   this->fPartContainer=c.fPartContainer;
   this->fEvtCutList=c.fEvtCutList;
   this->fPartCutList=c.fPartCutList;
+  this->fOrderByRejection=c.fOrderByRejection;
+  this->fNTrainOrdering=c.fNTrainOrdering;
+  this->fSelections=c.fSelections;
+  this->fCompiled=c.fCompiled;
   return *this ;
 }
 
@@ -105,11 +125,11 @@ Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, const TString
     return kTRUE;
   }
   if(!fPartCutList[isel])return kTRUE;
+  Bool_t all=selcuts.Contains("all");
   TObjArrayIter iter(fPartCutList[isel]);
   AliCFCutBase *cut = 0;
   while ( (cut = (AliCFCutBase*)iter.Next()) ) {
-    TString cutName=cut->GetName();
-    Bool_t checkCut=CompareStrings(cutName,selcuts);
+    Bool_t checkCut=all || CompareStrings(cut->GetName(),selcuts);
     if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
   }
   return kTRUE;
@@ -126,11 +146,11 @@ Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, const TString  &se
       return kTRUE;
   }
   if(!fEvtCutList[isel])return kTRUE;
+  Bool_t all=selcuts.Contains("all");
   TObjArrayIter iter(fEvtCutList[isel]);
   AliCFCutBase *cut = 0;
   while ( (cut = (AliCFCutBase*)iter.Next()) ) {
-    TString cutName=cut->GetName();
-    Bool_t checkCut=CompareStrings(cutName,selcuts);
+    Bool_t checkCut=all || CompareStrings(cut->GetName(),selcuts);
     if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
   }
   return kTRUE;
@@ -243,6 +263,7 @@ void AliCFManager::SetEventCutsList(Int_t isel, TObjArray* array) {
     return;
   }
   fEvtCutList[isel] = array;
+  for (UInt_t i=0; i<fCompiled.size(); i++) CompileSteps(fCompiled[i]);
 }
 
 //_____________________________________________________________________________
@@ -267,4 +288,182 @@ void AliCFManager::SetParticleCutsList(Int_t isel, TObjArray* array) {
     return;
   }
   fPartCutList[isel] = array;
+  for (UInt_t i=0; i<fCompiled.size(); i++) CompileSteps(fCompiled[i]);
+}
+
+//_____________________________________________________________________________
+Int_t AliCFManager::CompileSelection(const TString &selcuts) {
+  //
+  // Resolve the selection string into the cuts to be checked at each
+  // step and return the handle to be passed to the checkers.
+  // The compiled selection follows later changes of the cut lists
+  //
+
+  for (UInt_t i=0; i<fSelections.size(); i++) {
+    if (fSelections[i] == selcuts) return i;
+  }
+  fSelections.push_back(selcuts);
+  return fSelections.size()-1;
+}
+
+//_____________________________________________________________________________
+AliCFManager::CompiledSelection *AliCFManager::GetCompiledSelection(Int_t selection) const {
+  //
+  // Return the compiled selection of a handle from CompileSelection,
+  // compiling the selections not compiled yet (e.g. after streaming)
+  //
+
+  if (selection<0 || selection>=(Int_t)fSelections.size()) {
+    AliError(Form("Unknown compiled selection %d",selection));
+    return 0x0;
+  }
+  for (UInt_t i=fCompiled.size(); i<fSelections.size(); i++) {
+    fCompiled.push_back(CompiledSelection());
+    fCompiled.back().fSelection = fSelections[i];
+    CompileSteps(fCompiled.back());
+  }
+  return &fCompiled[selection];
+}
+
+//_____________________________________________________________________________
+void AliCFManager::CompileSteps(CompiledSelection &comp) const {
+  //
+  // Fill the lists of cuts of all the steps for a compiled selection
+  //
+
+  comp.fCuts.clear();
+  comp.fEvtSteps.assign(fNStepEvt, std::vector<Int_t>());
+  comp.fPartSteps.assign(fNStepPart, std::vector<Int_t>());
+  for (Int_t ilevel=0; ilevel<2; ilevel++) {
+    TObjArray **lists = (ilevel==0) ? fEvtCutList : fPartCutList;
+    std::vector<std::vector<Int_t> > &steps = (ilevel==0) ? comp.fEvtSteps : comp.fPartSteps;
+    if (!lists) continue;
+    for (UInt_t isel=0; isel<steps.size(); isel++) {
+      if (!lists[isel]) continue;
+      TObjArrayIter iter(lists[isel]);
+      AliCFCutBase *cut = 0;
+      while ( (cut = (AliCFCutBase*)iter.Next()) ) {
+        if (!CompareStrings(cut->GetName(),comp.fSelection)) continue;
+        Int_t index = std::find(comp.fCuts.begin(),comp.fCuts.end(),cut) - comp.fCuts.begin();
+        if (index == (Int_t)comp.fCuts.size()) comp.fCuts.push_back(cut);
+        steps[isel].push_back(index);
+      }
+    }
+  }
+  comp.fNTested.assign(comp.fCuts.size(),0);
+  comp.fNRejected.assign(comp.fCuts.size(),0);
+  comp.fNChecks = 0;
+  comp.fOrdered = kFALSE;
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckCompiledCuts(CompiledSelection &comp, const std::vector<Int_t> &step, TObject *obj) const {
+  //
+  // check the cuts of one step of a compiled selection
+  //
+
+  Bool_t measure = fOrderByRejection && !comp.fOrdered;
+  Bool_t pass = kTRUE;
+  for (UInt_t i=0; i<step.size(); i++) {
+    Int_t index = step[i];
+    if (comp.fCuts[index]->IsSelected(obj)) {
+      if (measure) comp.fNTested[index]++;
+      continue;
+    }
+    if (measure) {
+      comp.fNTested[index]++;
+      comp.fNRejected[index]++;
+    }
+    pass = kFALSE;
+    break;
+  }
+  if (measure && ++comp.fNChecks >= fNTrainOrdering) OrderCompiledCuts(comp);
+  return pass;
+}
+
+//_____________________________________________________________________________
+void AliCFManager::OrderCompiledCuts(CompiledSelection &comp) const {
+  //
+  // order the cuts of each step by decreasing measured rejection
+  //
+
+  std::vector<Double_t> rejection(comp.fCuts.size(),0.);
+  for (UInt_t i=0; i<comp.fCuts.size(); i++) {
+    if (comp.fNTested[i] > 0) rejection[i] = (Double_t)comp.fNRejected[i]/comp.fNTested[i];
+  }
+  for (Int_t ilevel=0; ilevel<2; ilevel++) {
+    std::vector<std::vector<Int_t> > &steps = (ilevel==0) ? comp.fEvtSteps : comp.fPartSteps;
+    for (UInt_t isel=0; isel<steps.size(); isel++) {
+      std::vector<Int_t> &step = steps[isel];
+      // insertion sort, stable and the lists are short
+      for (UInt_t i=1; i<step.size(); i++) {
+        Int_t index = step[i];
+        Int_t j = i;
+        for (; j>0 && rejection[step[j-1]] < rejection[index]; j--) step[j] = step[j-1];
+        step[j] = index;
+      }
+    }
+  }
+  comp.fOrdered = kTRUE;
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, Int_t selection) const {
+  //
+  // check whether object obj passes particle-level selection isel,
+  // using a selection from CompileSelection
+  //
+
+  CompiledSelection *compiled = GetCompiledSelection(selection);
+  if (!compiled) return kFALSE;
+  CompiledSelection &comp = *compiled;
+  if (isel<0 || isel>=(Int_t)comp.fPartSteps.size()) {
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepPart));
+    return kTRUE;
+  }
+  return CheckCompiledCuts(comp,comp.fPartSteps[isel],obj);
+}
+
+//_____________________________________________________________________________
+Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, Int_t selection) const {
+  //
+  // check whether object obj passes event-level selection isel,
+  // using a selection from CompileSelection
+  //
+
+  CompiledSelection *compiled = GetCompiledSelection(selection);
+  if (!compiled) return kFALSE;
+  CompiledSelection &comp = *compiled;
+  if (isel<0 || isel>=(Int_t)comp.fEvtSteps.size()) {
+    AliWarning(Form("Selection index out of Range! isel=%i, max. number of selections= %i", isel,fNStepEvt));
+    return kTRUE;
+  }
+  return CheckCompiledCuts(comp,comp.fEvtSteps[isel],obj);
+}
+
+//_____________________________________________________________________________
+UInt_t AliCFManager::CheckParticleSteps(TObject *obj, Int_t selection) const {
+  //
+  // check all the particle-level selection steps in one pass: bit isel of
+  // the result is set if obj passes the cuts of step isel (max. 32 steps).
+  // Each distinct cut is checked at most once
+  //
+
+  CompiledSelection *compiled = GetCompiledSelection(selection);
+  if (!compiled) return 0;
+  CompiledSelection &comp = *compiled;
+  fCutResults.assign(comp.fCuts.size(),-1);
+  UInt_t mask = 0;
+  Int_t nsteps = std::min((Int_t)comp.fPartSteps.size(),32);
+  for (Int_t isel=0; isel<nsteps; isel++) {
+    const std::vector<Int_t> &step = comp.fPartSteps[isel];
+    Bool_t pass = kTRUE;
+    for (UInt_t i=0; i<step.size() && pass; i++) {
+      Int_t index = step[i];
+      if (fCutResults[index] < 0) fCutResults[index] = comp.fCuts[index]->IsSelected(obj) ? 1 : 0;
+      pass = (fCutResults[index] == 1);
+    }
+    if (pass) mask |= (1u << isel);
+  }
+  return mask;
 }
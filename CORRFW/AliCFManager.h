@@ -24,10 +24,13 @@
 // now the number of steps are fixed by the particle/event containers themselves.
 //
 
+#include <vector>
 #include "TNamed.h"
 #include "AliCFContainer.h"
 #include "AliLog.h"
 
+class AliCFCutBase;
+
 //____________________________________________________________________________
 class AliCFManager : public TNamed 
 {
@@ -116,6 +119,21 @@ class AliCFManager : public TNamed
   virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
   virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
 
+  //Compiled selections: the selection string is resolved once into the
+  //list of cuts to check at each step, the returned handle is then used
+  //in place of the string. The selection strings are streamed with the
+  //manager and recompiled on first use, so the handles stay valid in the
+  //copies sent to the workers
+  virtual Int_t  CompileSelection(const TString &selcuts="all");
+  virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, Int_t selection) const;
+  virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, Int_t selection) const;
+  //bit isel of the result is set if obj passes the particle cuts of step isel,
+  //cuts appearing in several steps are checked only once
+  virtual UInt_t CheckParticleSteps(TObject *obj, Int_t selection) const;
+  //check the cuts of the compiled selections by decreasing rejection, as measured
+  //on the first ntrain objects (changes which cuts fill their QA histograms)
+  virtual void   SetOrderCutsByRejection(Bool_t flag=kTRUE, Int_t ntrain=1000) {fOrderByRejection=flag; fNTrainOrdering=ntrain;}
+
  private:
   
   //number of steps
@@ -132,7 +150,29 @@ class AliCFManager : public TNamed
 
   Bool_t CompareStrings(const TString  &cutname,const TString  &selcuts) const;
 
-  ClassDef(AliCFManager,2);
+  //compiled selections
+  struct CompiledSelection {
+    TString fSelection;                        // selection string
+    std::vector<AliCFCutBase*> fCuts;          // distinct cuts of all the steps
+    std::vector<std::vector<Int_t> > fEvtSteps;  // indices in fCuts for each event-selection step
+    std::vector<std::vector<Int_t> > fPartSteps; // indices in fCuts for each particle-selection step
+    std::vector<Long64_t> fNTested;            // number of objects checked by each cut
+    std::vector<Long64_t> fNRejected;          // number of objects rejected by each cut
+    Long64_t fNChecks;                         // number of checks while measuring the rejection
+    Bool_t fOrdered;                           // the cuts are ordered by rejection
+  };
+  Bool_t fOrderByRejection;  // order the cuts of the compiled selections by rejection
+  Int_t  fNTrainOrdering;    // number of checks used to measure the rejection
+  std::vector<TString> fSelections;  // selection strings of the handles returned by CompileSelection
+  mutable std::vector<CompiledSelection> fCompiled; //! compiled selections, rebuilt from fSelections when empty
+  mutable std::vector<Char_t> fCutResults;           //! results of the distinct cuts in CheckParticleSteps
+
+  void CompileSteps(CompiledSelection &comp) const;
+  CompiledSelection *GetCompiledSelection(Int_t selection) const;
+  Bool_t CheckCompiledCuts(CompiledSelection &comp, const std::vector<Int_t> &step, TObject *obj) const;
+  void OrderCompiledCuts(CompiledSelection &comp) const;
+
+  ClassDef(AliCFManager,3);
 };
 
 
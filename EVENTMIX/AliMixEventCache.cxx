@@ -0,0 +1,261 @@
+//
+// Class AliMixEventCache
+//
+// AliMixEventCache keeps slimmed copies of already processed
+// events in memory (ring buffer per event pool bin), so mixing
+// partners can be served without re-reading the input chain.
+// Tracks and clusters are stored as structure of arrays (one
+// contiguous float array per field).
+//
+
+#include <TMath.h>
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVVertex.h"
+#include "AliVParticle.h"
+#include "AliVCluster.h"
+#include "AliAODTrack.h"
+
+#include "AliMixEventCache.h"
+
+ClassImp(AliMixEventCache)
+
+//_________________________________________________________________________________________________
+AliMixEventCache::AliMixEventCache(const char *name, const char *title) : TNamed(name, title),
+   fNBins(0),
+   fDepth(10),
+   fMaxTracks(2000),
+   fMaxClusters(0),
+   fMemoryBudget(0.0),
+   fTrackPtMin(0.0),
+   fTrackPtMax(1e10),
+   fTrackEtaMax(1e10),
+   fTrackFilterBit(0),
+   fClusterEMin(0.0),
+   fTracks(),
+   fClusters(),
+   fNTracks(),
+   fNClusters(),
+   fEntry(),
+   fVertexZ(),
+   fHead(),
+   fFill(),
+   fNTruncated(0)
+{
+   //
+   // Default constructor.
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 5, "->");
+}
+
+//_________________________________________________________________________________________________
+AliMixEventCache::~AliMixEventCache()
+{
+   //
+   // Destructor
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 5, "->");
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::Print(const Option_t *) const
+{
+   //
+   // Prints usefull information
+   //
+   AliInfo(Form("bins=%d depth=%d maxTracks=%d maxClusters=%d memory=%.1f MB truncated=%lld",
+                fNBins, fDepth, fMaxTracks, fMaxClusters, GetMemoryUsage() / 1024.0 / 1024.0, fNTruncated));
+   for (Int_t iBin = 0; iBin < fNBins; iBin++) {
+      AliDebug(AliLog::kDebug, Form("Bin[%d] events=%d", iBin, fFill[iBin]));
+   }
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventCache::Init(Int_t nBins)
+{
+   //
+   // Allocates whole storage once. When memory budget is set, depth
+   // is calculated from it.
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   if (nBins < 1) {
+      AliError(Form("Number of bins %d is not valid", nBins));
+      return kFALSE;
+   }
+   if (fMaxTracks < 0) fMaxTracks = 0;
+   if (fMaxClusters < 0) fMaxClusters = 0;
+
+   if (fMemoryBudget > 0) {
+      Double_t bytesPerEvent = sizeof(Float_t) * (fMaxTracks * kNTrackFields + fMaxClusters * kNClusterFields + 1)
+                               + 2 * sizeof(Int_t) + sizeof(Long64_t);
+      fDepth = (Int_t)(fMemoryBudget * 1024 * 1024 / (bytesPerEvent * nBins));
+   }
+   if (fDepth < 1) {
+      AliWarning(Form("Depth %d is too small (memory budget %.1f MB) setting it to 1", fDepth, fMemoryBudget));
+      fDepth = 1;
+   }
+
+   fNBins = nBins;
+   Int_t nSlots = fNBins * fDepth;
+   fTracks.assign((size_t)nSlots * kNTrackFields * fMaxTracks, 0.0);
+   fClusters.assign((size_t)nSlots * kNClusterFields * fMaxClusters, 0.0);
+   fNTracks.assign(nSlots, 0);
+   fNClusters.assign(nSlots, 0);
+   fEntry.assign(nSlots, -1);
+   fVertexZ.assign(nSlots, 0.0);
+   fHead.assign(fNBins, 0);
+   fFill.assign(fNBins, 0);
+   fNTruncated = 0;
+
+   AliInfo(Form("Allocated %.1f MB for %d bins with depth %d", GetMemoryUsage() / 1024.0 / 1024.0, fNBins, fDepth));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::Reset()
+{
+   //
+   // Forgets all cached events (storage is kept)
+   //
+   for (Int_t iBin = 0; iBin < fNBins; iBin++) {
+      fHead[iBin] = 0;
+      fFill[iBin] = 0;
+   }
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventCache::GetMemoryUsage() const
+{
+   //
+   // Returns allocated memory in bytes
+   //
+   return (Long64_t)(fTracks.size() + fClusters.size() + fVertexZ.size()) * sizeof(Float_t) +
+          (Long64_t)(fNTracks.size() + fNClusters.size() + fHead.size() + fFill.size()) * sizeof(Int_t) +
+          (Long64_t)fEntry.size() * sizeof(Long64_t);
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventCache::AddEvent(AliVEvent *ev, Int_t bin, Long64_t entry)
+{
+   //
+   // Copies selected tracks and clusters of event to next slot in bin
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   if (!ev || bin < 0 || bin >= fNBins) {
+      AliDebug(AliLog::kDebug, Form("Entry %lld was NOT cached (bin %d) !!!", entry, bin));
+      return kFALSE;
+   }
+
+   Int_t slot = fHead[bin];
+   Int_t idx = Index(bin, slot);
+   Bool_t truncated = kFALSE;
+
+   Float_t *pt = &fTracks[((size_t)idx * kNTrackFields + kTrackPt) * fMaxTracks];
+   Float_t *eta = pt + (kTrackEta - kTrackPt) * fMaxTracks;
+   Float_t *phi = pt + (kTrackPhi - kTrackPt) * fMaxTracks;
+   Float_t *charge = pt + (kTrackCharge - kTrackPt) * fMaxTracks;
+   Int_t nTracks = 0;
+   Int_t nAll = (fMaxTracks > 0) ? ev->GetNumberOfTracks() : 0;
+   for (Int_t i = 0; i < nAll; i++) {
+      AliVParticle *track = ev->GetTrack(i);
+      if (!track) continue;
+      if (fTrackFilterBit) {
+         AliAODTrack *aodTrack = dynamic_cast<AliAODTrack *>(track);
+         if (aodTrack && !aodTrack->TestFilterBit(fTrackFilterBit)) continue;
+      }
+      Float_t trackPt = track->Pt();
+      if (trackPt < fTrackPtMin || trackPt > fTrackPtMax) continue;
+      Float_t trackEta = track->Eta();
+      if (TMath::Abs(trackEta) > fTrackEtaMax) continue;
+      if (nTracks >= fMaxTracks) {
+         truncated = kTRUE;
+         break;
+      }
+      pt[nTracks] = trackPt;
+      eta[nTracks] = trackEta;
+      phi[nTracks] = track->Phi();
+      charge[nTracks] = track->Charge();
+      nTracks++;
+   }
+
+   Int_t nClusters = 0;
+   if (fMaxClusters > 0) {
+      Float_t *cE = &fClusters[((size_t)idx * kNClusterFields + kClusterE) * fMaxClusters];
+      Float_t *cEta = cE + (kClusterEta - kClusterE) * fMaxClusters;
+      Float_t *cPhi = cE + (kClusterPhi - kClusterE) * fMaxClusters;
+      Float_t pos[3];
+      for (Int_t i = 0; i < ev->GetNumberOfCaloClusters(); i++) {
+         AliVCluster *cluster = ev->GetCaloCluster(i);
+         if (!cluster || cluster->E() < fClusterEMin) continue;
+         if (nClusters >= fMaxClusters) {
+            truncated = kTRUE;
+            break;
+         }
+         cluster->GetPosition(pos);
+         Float_t r = TMath::Sqrt(pos[0] * pos[0] + pos[1] * pos[1]);
+         cE[nClusters] = cluster->E();
+         cEta[nClusters] = (r > 0) ? TMath::ASinH(pos[2] / r) : 0.0;
+         cPhi[nClusters] = TMath::ATan2(pos[1], pos[0]);
+         if (cPhi[nClusters] < 0) cPhi[nClusters] += TMath::TwoPi();
+         nClusters++;
+      }
+   }
+
+   if (truncated) fNTruncated++;
+   const AliVVertex *vtx = ev->GetPrimaryVertex();
+   fNTracks[idx] = nTracks;
+   fNClusters[idx] = nClusters;
+   fEntry[idx] = entry;
+   fVertexZ[idx] = vtx ? vtx->GetZ() : 0.0;
+
+   fHead[bin] = (slot + 1) % fDepth;
+   if (fFill[bin] < fDepth) fFill[bin]++;
+
+   AliDebug(AliLog::kDebug, Form("Entry %lld was cached in bin %d slot %d (tracks=%d clusters=%d)", entry, bin, slot, nTracks, nClusters));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventCache::GetNEvents(Int_t bin) const
+{
+   //
+   // Returns number of cached events in bin
+   //
+   if (bin < 0 || bin >= fNBins) return 0;
+   return fFill[bin];
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventCache::GetSlot(Int_t bin, Int_t iMix) const
+{
+   //
+   // Returns slot of iMix-th newest event in bin (0 is the newest)
+   //
+   if (iMix < 0 || iMix >= GetNEvents(bin)) return -1;
+   return (fHead[bin] - 1 - iMix + 2 * fDepth) % fDepth;
+}
+
+//_________________________________________________________________________________________________
+const Float_t *AliMixEventCache::GetTrackField(Int_t bin, Int_t slot, ETrackField_t field) const
+{
+   //
+   // Returns array (GetNTracks() long) of track field
+   //
+   if (fMaxTracks == 0) return 0;
+   return &fTracks[((size_t)Index(bin, slot) * kNTrackFields + field) * fMaxTracks];
+}
+
+//_________________________________________________________________________________________________
+const Float_t *AliMixEventCache::GetClusterField(Int_t bin, Int_t slot, EClusterField_t field) const
+{
+   //
+   // Returns array (GetNClusters() long) of cluster field
+   //
+   if (fMaxClusters == 0) return 0;
+   return &fClusters[((size_t)Index(bin, slot) * kNClusterFields + field) * fMaxClusters];
+}
@@ -0,0 +1,99 @@
+//
+// Class AliMixEventCache
+//
+// AliMixEventCache keeps slimmed copies of already processed
+// events in memory (ring buffer per event pool bin), so mixing
+// partners can be served without re-reading the input chain.
+// Tracks and clusters are stored as structure of arrays (one
+// contiguous float array per field).
+//
+
+#ifndef ALIMIXEVENTCACHE_H
+#define ALIMIXEVENTCACHE_H
+
+#include <vector>
+
+#include <TNamed.h>
+
+class AliVEvent;
+class AliMixEventCache : public TNamed {
+public:
+   enum ETrackField_t { kTrackPt = 0, kTrackEta = 1, kTrackPhi = 2, kTrackCharge = 3, kNTrackFields = 4 };
+   enum EClusterField_t { kClusterE = 0, kClusterEta = 1, kClusterPhi = 2, kNClusterFields = 3 };
+
+   AliMixEventCache(const char *name = "mixEventCache", const char *title = "Mix event cache");
+   virtual ~AliMixEventCache();
+
+   virtual void      Print(const Option_t *option = "") const;
+
+   // allocates storage for nBins pool bins
+   Bool_t            Init(Int_t nBins);
+   Bool_t            NeedInit() const { return (fNBins == 0); }
+   void              Reset();
+
+   // configuration (has to be done before Init)
+   void              SetDepth(Int_t depth) { fDepth = depth; }
+   void              SetMaxTracks(Int_t n) { fMaxTracks = n; }
+   void              SetMaxClusters(Int_t n) { fMaxClusters = n; }
+   void              SetMemoryBudget(Double_t mb) { fMemoryBudget = mb; }
+   void              SetTrackCuts(Float_t ptMin, Float_t ptMax, Float_t etaMax) { fTrackPtMin = ptMin; fTrackPtMax = ptMax; fTrackEtaMax = etaMax; }
+   void              SetTrackFilterBit(UInt_t bit) { fTrackFilterBit = bit; }
+   void              SetClusterEMin(Float_t eMin) { fClusterEMin = eMin; }
+
+   // fills current event to bin (oldest event in bin is overwritten)
+   Bool_t            AddEvent(AliVEvent *ev, Int_t bin, Long64_t entry);
+
+   Int_t             GetNBins() const { return fNBins; }
+   Int_t             GetDepth() const { return fDepth; }
+   Int_t             GetMaxTracks() const { return fMaxTracks; }
+   Int_t             GetMaxClusters() const { return fMaxClusters; }
+   Long64_t          GetMemoryUsage() const;
+
+   // number of cached events in bin
+   Int_t             GetNEvents(Int_t bin) const;
+   // slot of the iMix-th newest event in bin (-1 if not available)
+   Int_t             GetSlot(Int_t bin, Int_t iMix) const;
+
+   Int_t             GetNTracks(Int_t bin, Int_t slot) const { return fNTracks[Index(bin, slot)]; }
+   Int_t             GetNClusters(Int_t bin, Int_t slot) const { return fNClusters[Index(bin, slot)]; }
+   Long64_t          GetEntry(Int_t bin, Int_t slot) const { return fEntry[Index(bin, slot)]; }
+   Float_t           GetVertexZ(Int_t bin, Int_t slot) const { return fVertexZ[Index(bin, slot)]; }
+   const Float_t    *GetTrackField(Int_t bin, Int_t slot, ETrackField_t field) const;
+   const Float_t    *GetClusterField(Int_t bin, Int_t slot, EClusterField_t field) const;
+
+   Long64_t          GetNTruncated() const { return fNTruncated; }
+
+private:
+
+   Int_t             Index(Int_t bin, Int_t slot) const { return bin * fDepth + slot; }
+
+   Int_t             fNBins;              // number of pool bins
+   Int_t             fDepth;              // number of events kept per bin
+   Int_t             fMaxTracks;          // max number of tracks stored per event
+   Int_t             fMaxClusters;        // max number of clusters stored per event
+   Double_t          fMemoryBudget;       // memory budget in MB (overrides fDepth when > 0)
+
+   Float_t           fTrackPtMin;         // min track pt
+   Float_t           fTrackPtMax;         // max track pt
+   Float_t           fTrackEtaMax;        // max track |eta|
+   UInt_t            fTrackFilterBit;     // AOD filter bit (0 means no check)
+   Float_t           fClusterEMin;        // min cluster energy
+
+   std::vector<Float_t>  fTracks;         //! track fields [bin][slot][field][track]
+   std::vector<Float_t>  fClusters;       //! cluster fields [bin][slot][field][cluster]
+   std::vector<Int_t>    fNTracks;        //! number of tracks [bin][slot]
+   std::vector<Int_t>    fNClusters;      //! number of clusters [bin][slot]
+   std::vector<Long64_t> fEntry;          //! chain entry [bin][slot]
+   std::vector<Float_t>  fVertexZ;        //! primary vertex z [bin][slot]
+   std::vector<Int_t>    fHead;           //! next slot to write [bin]
+   std::vector<Int_t>    fFill;           //! number of filled slots [bin]
+
+   Long64_t          fNTruncated;         //! number of events with truncated track/cluster list
+
+   AliMixEventCache(const AliMixEventCache &obj);
+   AliMixEventCache &operator=(const AliMixEventCache &obj);
+
+   ClassDef(AliMixEventCache, 1)
+};
+
+#endif
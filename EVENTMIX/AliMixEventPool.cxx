@@ -9,6 +9,7 @@
 //
 
 #include <TEntryList.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliMixEventCutObj.h"
@@ -23,7 +24,13 @@ AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(n
    fListOfEventCuts(),
    fBinNumber(0),
    fBufferSize(0),
-   fMixNumber(0)
+   fMixNumber(0),
+   fMaxEntriesPerBin(0),
+   fBinStrides(),
+   fBinHead(),
+   fBinRing(),
+   fBinFills(),
+   fBinEvictions()
 {
    //
    // Default constructor.
@@ -37,7 +44,13 @@ AliMixEventPool::AliMixEventPool(const AliMixEventPool &obj) : TNamed(obj),
    fListOfEventCuts(obj.fListOfEventCuts),
    fBinNumber(obj.fBinNumber),
    fBufferSize(obj.fBufferSize),
-   fMixNumber(obj.fMixNumber)
+   fMixNumber(obj.fMixNumber),
+   fMaxEntriesPerBin(obj.fMaxEntriesPerBin),
+   fBinStrides(obj.fBinStrides),
+   fBinHead(obj.fBinHead),
+   fBinRing(obj.fBinRing),
+   fBinFills(obj.fBinFills),
+   fBinEvictions(obj.fBinEvictions)
 {
    //
    // Copy constructor
@@ -59,6 +72,12 @@ AliMixEventPool &AliMixEventPool::operator=(const AliMixEventPool &obj)
       fBinNumber = obj.fBinNumber;
       fBufferSize = obj.fBufferSize;
       fMixNumber = obj.fMixNumber;
+      fMaxEntriesPerBin = obj.fMaxEntriesPerBin;
+      fBinStrides = obj.fBinStrides;
+      fBinHead = obj.fBinHead;
+      fBinRing = obj.fBinRing;
+      fBinFills = obj.fBinFills;
+      fBinEvictions = obj.fBinEvictions;
    }
    return *this;
 }
@@ -94,10 +113,8 @@ void AliMixEventPool::Print(const Option_t *option) const
       cut->Print(option);
    }
    AliDebug(AliLog::kDebug, Form("NumOfEntryList %d", fListOfEntryList.GetEntries()));
-   TEntryList *el;
    for (Int_t i = 0; i < fListOfEntryList.GetEntries(); i++) {
-      el = (TEntryList *) fListOfEntryList.At(i);
-      AliDebug(AliLog::kDebug, Form("EntryList[%d] %lld", i, el->GetN()));
+      AliDebug(AliLog::kDebug, Form("EntryList[%d] %lld (fills=%lld evictions=%lld)", i, GetNEntries(i + 1), GetBinFills(i + 1), GetBinEvictions(i + 1)));
    }
 }
 //_________________________________________________________________________________________________
@@ -111,6 +128,28 @@ Int_t AliMixEventPool::Init()
    fBinNumber++;
    AliDebug(AliLog::kDebug, Form("fBinnumber = %d", fBinNumber));
    AddEntryList();
+
+   // strides for flat bin index (first cut is changing fastest)
+   Int_t numCuts = fListOfEventCuts.GetEntriesFast();
+   fBinStrides.Set(numCuts);
+   Int_t stride = 1;
+   for (Int_t i = 0; i < numCuts; i++) {
+      fBinStrides[i] = stride;
+      stride *= ((AliMixEventCutObj *) fListOfEventCuts.At(i))->GetNumberOfBins();
+   }
+
+   Int_t nBins = fListOfEntryList.GetEntriesFast();
+   fBinFills.Set(nBins);
+   fBinFills.Reset();
+   fBinEvictions.Set(nBins);
+   fBinEvictions.Reset();
+   if (IsBounded()) {
+      fBinHead.Set(nBins);
+      fBinHead.Reset();
+      fBinRing.Set(nBins * fMaxEntriesPerBin);
+      fBinRing.Reset(-1);
+      AliDebug(AliLog::kDebug, Form("Bounded pool with %d entries per bin", fMaxEntriesPerBin));
+   }
    AliDebug(AliLog::kDebug + 5, "->");
    return 0;
 }
@@ -173,10 +212,18 @@ Bool_t AliMixEventPool::AddEntry(Long64_t entry, AliVEvent *ev)
       AliDebug(AliLog::kDebug, Form("Entry %lld was NOT added !!!", entry));
       return kFALSE;
    }
-   Int_t idEntryList = -1;
-   TEntryList *el =  FindEntryList(ev, idEntryList);
-   if (el) {
-      el->Enter(entry);
+   Int_t idEntryList = FindBinIndex(ev);
+   if (idEntryList > 0) {
+      Int_t bin = idEntryList - 1;
+      if (IsBounded()) {
+         // overwrites oldest entry when bin is full
+         if (fBinFills[bin] >= fMaxEntriesPerBin) fBinEvictions[bin]++;
+         fBinRing[bin * fMaxEntriesPerBin + fBinHead[bin]] = entry;
+         fBinHead[bin] = (fBinHead[bin] + 1) % fMaxEntriesPerBin;
+      } else {
+         ((TEntryList *) fListOfEntryList.At(bin))->Enter(entry);
+      }
+      fBinFills[bin]++;
       AliDebug(AliLog::kDebug, Form("Entry %lld was added with idEntryList %d !!!", entry, idEntryList));
       return kTRUE;
    }
@@ -192,33 +239,84 @@ TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
    // Find entrlist in list of entrlist
    //
    AliDebug(AliLog::kDebug + 5, "<-");
+   idEntryList = FindBinIndex(ev);
+   if (idEntryList < 1) return 0;
+   AliDebug(AliLog::kDebug + 5, "->");
+   return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::FindBinIndex(AliVEvent *ev)
+{
+   //
+   // Finds index of entry list (starting from 1) from precomputed strides.
+   // Returns -1 when event is out of range of any cut.
+   //
    Int_t num = fListOfEventCuts.GetEntriesFast();
-   if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
+   if (num < 1 || fBinStrides.GetSize() != num) return -1;
+   Int_t idEntryList = 1;
    AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
+   for (Int_t i = 0; i < num; i++) {
+      cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      Int_t index = cut->GetIndex(ev);
+      if (index < 0) {
          AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
-         return 0;
+         return -1;
       }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
+      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, index));
+      idEntryList += (index - 1) * fBinStrides[i];
    }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
+   if (idEntryList > fListOfEntryList.GetEntriesFast()) return -1;
    AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
-   // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
-   AliDebug(AliLog::kDebug + 5, "->");
-   return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
+   return idEntryList;
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventPool::GetNEntries(Int_t idEntryList) const
+{
+   //
+   // Returns number of entries available in bin
+   //
+   if (idEntryList < 1 || idEntryList > fListOfEntryList.GetEntriesFast()) return 0;
+   Int_t bin = idEntryList - 1;
+   if (IsBounded()) return TMath::Min(fBinFills[bin], (Long64_t) fMaxEntriesPerBin);
+   return ((TEntryList *) fListOfEntryList.At(bin))->GetN();
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventPool::GetEntry(Int_t idEntryList, Long64_t index) const
+{
+   //
+   // Returns index-th entry in bin (0 is the oldest one kept)
+   //
+   Long64_t n = GetNEntries(idEntryList);
+   if (index < 0 || index >= n) return -1;
+   Int_t bin = idEntryList - 1;
+   if (IsBounded()) {
+      Long64_t slot = (fBinHead[bin] - n + index + fMaxEntriesPerBin) % fMaxEntriesPerBin;
+      return fBinRing[bin * fMaxEntriesPerBin + slot];
+   }
+   return ((TEntryList *) fListOfEntryList.At(bin))->GetEntry(index);
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventPool::GetBinFills(Int_t idEntryList) const
+{
+   //
+   // Returns number of entries added to bin
+   //
+   if (idEntryList < 1 || idEntryList > fBinFills.GetSize()) return 0;
+   return fBinFills[idEntryList - 1];
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventPool::GetBinEvictions(Int_t idEntryList) const
+{
+   //
+   // Returns number of entries removed from bin (bounded mode)
+   //
+   if (idEntryList < 1 || idEntryList > fBinEvictions.GetSize()) return 0;
+   return fBinEvictions[idEntryList - 1];
 }
 
 //_________________________________________________________________________________________________
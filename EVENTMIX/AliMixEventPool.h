@@ -12,6 +12,8 @@
 #define ALIMIXEVENTPOOL_H
 
 #include <TObjArray.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
 #include <TNamed.h>
 
 class TEntryList;
@@ -36,6 +38,11 @@ public:
 
    Bool_t      AddEntry(Long64_t entry, AliVEvent *ev);
    TEntryList *FindEntryList(AliVEvent *ev, Int_t &idEntryList);
+   Int_t       FindBinIndex(AliVEvent *ev);
+
+   // access to entries in bin (idEntryList as returned by FindEntryList), oldest first
+   Long64_t    GetNEntries(Int_t idEntryList) const;
+   Long64_t    GetEntry(Int_t idEntryList, Long64_t index) const;
 
    void        AddCut(AliMixEventCutObj *cut);
 
@@ -49,6 +56,14 @@ public:
    Int_t       GetBufferSize() const { return fBufferSize; }
    Int_t       GetMixNumber() const { return fMixNumber; }
 
+   // bounded mode: keep only last 'depth' entries per bin (FIFO) instead of growing entry lists
+   void        SetMaxEntriesPerBin(Int_t depth) { fMaxEntriesPerBin = depth; }
+   Int_t       GetMaxEntriesPerBin() const { return fMaxEntriesPerBin; }
+   Bool_t      IsBounded() const { return (fMaxEntriesPerBin > 0); }
+   Int_t       GetNBins() const { return fListOfEntryList.GetEntriesFast(); }
+   Long64_t    GetBinFills(Int_t idEntryList) const;
+   Long64_t    GetBinEvictions(Int_t idEntryList) const;
+
 private:
 
    TObjArray   fListOfEntryList;       // list of entry lists
@@ -57,8 +72,15 @@ private:
    Int_t       fBinNumber;             // bin number
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
+   Int_t       fMaxEntriesPerBin;      // max entries per bin (0 means unbounded entry lists)
+
+   TArrayI     fBinStrides;            //! stride of every cut in flat bin index
+   TArrayI     fBinHead;               //! next ring slot per bin (bounded mode)
+   TArrayL64   fBinRing;               //! ring of entries [bin][depth] (bounded mode)
+   TArrayL64   fBinFills;              //! number of entries added per bin
+   TArrayL64   fBinEvictions;          //! number of entries evicted per bin (bounded mode)
 
-   ClassDef(AliMixEventPool, 1)
+   ClassDef(AliMixEventPool, 2)
 };
 
 #endif
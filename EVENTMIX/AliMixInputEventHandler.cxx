@@ -17,6 +17,7 @@
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventCache.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -31,6 +32,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fMixIntupHandlerInfoTmp(0),
    fEntryCounter(0),
    fEventPool(0),
+   fEventCache(0),
    fNumberMixed(0),
    fMixNumber(mixNum),
    fUseDefautProcess(kFALSE),
@@ -43,7 +45,9 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fCurrentCacheBin(-1),
+   fCurrentCacheSlot(-1)
 {
    //
    // Default constructor.
@@ -192,7 +196,10 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
-   if (!fEventPool) {
+   if (fEventCache) {
+      MixCache();
+   }
+   else if (!fEventPool) {
       MixStd();
    }
    // if buffer size is higher then 1
@@ -320,7 +327,7 @@ Bool_t AliMixInputEventHandler::MixBuffer()
       UserExecMixAllTasks(fEntryCounter, -1, fEntryCounter, -1, 0);
       return kTRUE;
    } else {
-      elNum = el->GetN();
+      elNum = fEventPool->GetNEntries(idEntryList);
       if (elNum < fBufferSize + 1) {
          UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, -1, 0);
          AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%lld) LESS THEN BUFFER +++++++++++++++++++", fEntryCounter, elNum));
@@ -339,7 +346,7 @@ Bool_t AliMixInputEventHandler::MixBuffer()
          if (elNum >= fBufferSize) {
             Long64_t entryInEntryList =  elNum - 2 - counter;
             if (entryInEntryList < 0) break;
-            entryMix = el->GetEntry(entryInEntryList);
+            entryMix = fEventPool->GetEntry(idEntryList, entryInEntryList);
          }
       }
       AliDebug(AliLog::kDebug + 5, Form("Handler[%d] entryMix %lld ", counter, entryMix));
@@ -426,7 +433,7 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
          return kTRUE;
       }
    } else {
-      elNum = el->GetN();
+      elNum = fEventPool->GetNEntries(idEntryList);
       if (elNum < fBufferSize + 1) {
          if (fDoMixIfNotEnoughEvents) {
             // include main event in to counter in this case (so idEntryList>0)
@@ -462,7 +469,7 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
       Long64_t entryInEntryList =  elNum - 2 - counter;
       AliDebug(AliLog::kDebug + 3, Form("entryInEntryList=%lld", entryInEntryList));
       if (entryInEntryList < 0) break;
-      entryMix = el->GetEntry(entryInEntryList);
+      entryMix = fEventPool->GetEntry(idEntryList, entryInEntryList);
       AliDebug(AliLog::kDebug + 3, Form("entryMix=%lld", entryMix));
       if (entryMix < 0) break;
       entryMixReal = entryMix;
@@ -495,6 +502,79 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
    return kFALSE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixCache()
+{
+   //
+   // Mix with events from in-memory cache (no GetEntry for mixed events).
+   // Mixed event is accessed in UserExecMix via GetEventCache() with
+   // CurrentCacheBin() and CurrentCacheSlot()
+   //
+   AliDebug(AliLog::kDebug + 5, Form("<-"));
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   // cache has one bin per entry list of event pool (or one bin without pool)
+   if (fEventCache->NeedInit()) {
+      Int_t nBins = 1;
+      if (fEventPool && fEventPool->GetListOfEventCuts()->GetEntries() > 0) nBins = fEventPool->GetListOfEntryLists()->GetEntries();
+      if (!fEventCache->Init(nBins)) return kFALSE;
+   }
+
+   // find out zero chain entries
+   Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
+   Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+
+   Int_t idEntryList = 1;
+   if (fEventPool && fEventPool->GetListOfEventCuts()->GetEntries() > 0) {
+      idEntryList = -1;
+      if (!fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList)) idEntryList = -1;
+   }
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   fNumberMixed = 0;
+   fCurrentCacheSlot = -1;
+   fCurrentCacheBin = idEntryList - 1;
+   if (idEntryList < 0) {
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (el null) +++++++++++++++++++", fEntryCounter));
+      UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
+      return kTRUE;
+   }
+
+   Int_t nCached = fEventCache->GetNEvents(fCurrentCacheBin);
+   Int_t mixNum = (fBufferSize > fMixNumber) ? fBufferSize : fMixNumber;
+   if (fDoMixExtra && nCached > mixNum && nCached <= 2 * mixNum) mixNum = nCached;
+   if (nCached < mixNum && !fDoMixIfNotEnoughEvents) {
+      UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, -1, 0);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%d) NOT ENOUGH EVENTS TO MIX => NEED=%d +++++++++++++++++++", fEntryCounter, nCached, mixNum));
+   } else {
+      for (Int_t counter = 0; counter < mixNum; counter++) {
+         fCurrentCacheSlot = fEventCache->GetSlot(fCurrentCacheBin, counter);
+         if (fCurrentCacheSlot < 0) break;
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, fEventCache->GetEntry(fCurrentCacheBin, fCurrentCacheSlot), fNumberMixed);
+      }
+      if (!fNumberMixed) UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, -1, 0);
+   }
+
+   // current event is available for mixing from next event on
+   fEventCache->AddEvent(inEvHMain->GetEvent(), fCurrentCacheBin, currentMainEntry);
+   fCurrentCacheSlot = -1;
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, Form("->"));
+   return kTRUE;
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::FinishEvent()
 {
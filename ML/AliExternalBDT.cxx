@@ -13,10 +13,13 @@
 #include "AliExternalBDT.h"
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <TSystem.h>
+
 namespace {
   inline bool checkFile (const std::string name) {
     FILE *file = fopen(name.c_str(), "r");
@@ -35,8 +38,14 @@ AliExternalBDT::AliExternalBDT(std::string name) :
   fModelPath{""},
   fModelName{""},
   fCompiler{},
-  fPredictor{}
+  fPredictor{},
+  fNThreads{1},
+  fCompileProfile{kFastCompile},
+  fCacheDir{""},
+  fEntries{}
 {
+  const char *cacheDir = getenv("ALIEXTERNALBDT_CACHE");
+  if (cacheDir) fCacheDir = cacheDir;
 }
 
 
@@ -46,7 +55,7 @@ bool AliExternalBDT::CompileAndLoadModelLibrary() {
     std::cout << "Library found: " << path.data() << "/main.so . Loading it!" << std::endl;
   } else {
     std::cout << "Starting the model compilation, depending on the model size it can take a while..." << std::endl;
-    system((std::string("gcc -c -O1 -fPIC ") + path + "/main.c -o " + path + "/main.o && gcc -shared " + path + \
+    system((std::string("gcc -c ") + GetCompilerFlags() + " -fPIC " + path + "/main.c -o " + path + "/main.o && gcc -shared " + path + \
           "/main.o -o " + path + "/main.so").data());
   }
   return LoadModelLibrary(path + "/main.so");
@@ -72,6 +81,48 @@ bool AliExternalBDT::CreateModelCode() {
   return true;
 }
 
+std::string AliExternalBDT::GetCompilerFlags() const {
+  switch (fCompileProfile) {
+    case kOptimisedCompile:
+      return "-O3";
+    case kNativeCompile:
+      return "-O3 -march=native";
+    default:
+      return "-O1";
+  }
+}
+
+std::string AliExternalBDT::GetCompilerTarget() const {
+  if (fCompileProfile != kNativeCompile) return "";
+  /// target options gcc resolves -march=native to on this host (e.g. -march=skylake and the enabled ISA extensions)
+  TString target = gSystem->GetFromPipe("gcc -march=native -Q --help=target 2>/dev/null");
+  return target.Data();
+}
+
+std::string AliExternalBDT::HashFile(const std::string &path, const std::string &salt) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == NULL) return "";
+  /// 64 bit FNV-1a over the file content followed by the salt
+  unsigned long long hash = 14695981039346656037ull;
+  const unsigned long long prime = 1099511628211ull;
+  unsigned char buffer[65536];
+  size_t nRead = 0;
+  while ((nRead = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    for (size_t iByte = 0; iByte < nRead; ++iByte) {
+      hash ^= buffer[iByte];
+      hash *= prime;
+    }
+  }
+  fclose(file);
+  for (size_t iChar = 0; iChar < salt.size(); ++iChar) {
+    hash ^= static_cast<unsigned char>(salt[iChar]);
+    hash *= prime;
+  }
+  char hex[17];
+  snprintf(hex, sizeof(hex), "%016llx", hash);
+  return hex;
+}
+
 std::string AliExternalBDT::GetUniquePath() {
   if (fBDTname.empty()) {
     return fModelName + std::to_string((unsigned long)this);
@@ -87,6 +138,22 @@ bool AliExternalBDT::LoadModel(const std::string &path, int type) {
   }
   fModelPath = path;
   fModelName = fModelPath.substr(fModelPath.find_last_of("\\/")+1,fModelPath.size());
+
+  /// look for the model in the cache of compiled libraries
+  std::string cachedLibrary = "";
+  if (!fCacheDir.empty()) {
+    /// native builds are keyed also by the host target and not cached if it cannot be resolved
+    const std::string target = GetCompilerTarget();
+    std::string key = HashFile(fModelPath, std::to_string(type) + " " + GetCompilerFlags() + " " + target);
+    if (!key.empty() && (fCompileProfile != kNativeCompile || !target.empty())) {
+      cachedLibrary = fCacheDir + "/" + key + ".so";
+      if (checkFile(cachedLibrary)) {
+        std::cout << "Library found in cache: " << cachedLibrary << " . Loading it!" << std::endl;
+        return LoadModelLibrary(cachedLibrary);
+      }
+    }
+  }
+
   int status = 0;
   switch (type) {
     case 0:
@@ -105,6 +172,18 @@ bool AliExternalBDT::LoadModel(const std::string &path, int type) {
   }
   if (!CreateModelCode()) return false;
   if (!CompileAndLoadModelLibrary()) return false;
+
+  /// store the library in the cache, the rename makes it visible to other jobs only when complete
+  if (!cachedLibrary.empty()) {
+    std::string tmpLibrary = cachedLibrary + "." + std::to_string((unsigned long)this) + ".tmp";
+    /// mkdir fails also if the directory already exists
+    const bool hasDir = gSystem->mkdir(fCacheDir.data(), kTRUE) == 0 || !gSystem->AccessPathName(fCacheDir.data());
+    if (!hasDir || gSystem->CopyFile((GetUniquePath() + "/main.so").data(), tmpLibrary.data(), kTRUE) != 0 ||
+        rename(tmpLibrary.data(), cachedLibrary.data()) != 0) {
+      std::cerr << "Failed to store the compiled model in the cache " << fCacheDir << std::endl;
+      remove(tmpLibrary.data());
+    }
+  }
   return true;
 }
 
@@ -119,7 +198,7 @@ bool AliExternalBDT::LoadLightGBMModel(std::string path) {
 }
 
 bool AliExternalBDT::LoadModelLibrary(std::string path) {
-  const int status = TreelitePredictorLoad(path.data(), 1, &fPredictor);
+  const int status = TreelitePredictorLoad(path.data(), fNThreads, &fPredictor);
   if (status != 0) {
     std::cerr << "Library loading failed" << std::endl;
     return false;
@@ -127,17 +206,41 @@ bool AliExternalBDT::LoadModelLibrary(std::string path) {
   return true;
 }
 
-double AliExternalBDT::Predict(double *features, int size, bool useRawScore) {
-  std::vector<TreelitePredictorEntry> entries(size);
-  for (size_t iEntry = 0; iEntry < entries.size(); ++iEntry) {
-    entries[iEntry].fvalue = static_cast<float>(features[iEntry]);
+double AliExternalBDT::Predict(const double *features, int size, bool useRawScore) {
+  fEntries.resize(size);
+  for (size_t iEntry = 0; iEntry < fEntries.size(); ++iEntry) {
+    fEntries[iEntry].fvalue = static_cast<float>(features[iEntry]);
   }
   size_t out_size{0u};
   TreelitePredictorQueryResultSizeSingleInst(fPredictor, &out_size);
   assert(out_size == 1);
   float output = 0.f;
-  TreelitePredictorPredictInst(fPredictor, entries.data(),
+  TreelitePredictorPredictInst(fPredictor, fEntries.data(),
       static_cast<int>(useRawScore), &output,
       &out_size);
   return output;
 }
+
+bool AliExternalBDT::PredictBatch(const float *features, size_t nRows, int nCols, float *scores, bool useRawScore) {
+  if (nRows == 0) return true;
+  DenseBatchHandle batch;
+  if (TreeliteAssembleDenseBatch(features, NAN, nRows, static_cast<size_t>(nCols), &batch) != 0) {
+    std::cerr << "Batch assembly failed" << std::endl;
+    return false;
+  }
+  size_t out_size{0u};
+  TreelitePredictorQueryResultSize(fPredictor, batch, 0, &out_size);
+  if (out_size != nRows) {
+    std::cerr << "Multi-class models are not supported in batch prediction" << std::endl;
+    TreeliteDeleteDenseBatch(batch);
+    return false;
+  }
+  const int status = TreelitePredictorPredictBatch(fPredictor, batch, 0, 0,
+      static_cast<int>(useRawScore), scores, &out_size);
+  TreeliteDeleteDenseBatch(batch);
+  if (status != 0) {
+    std::cerr << "Batch prediction failed" << std::endl;
+    return false;
+  }
+  return true;
+}
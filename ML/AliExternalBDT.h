@@ -22,6 +22,10 @@
 
 class AliExternalBDT {
 public:
+  /// optimisation profiles for the compilation of the generated model code
+  /// (libraries built with kNativeCompile are cached per host target resolved by gcc)
+  enum { kFastCompile, kOptimisedCompile, kNativeCompile };
+
   AliExternalBDT(std::string name = "");
   virtual ~AliExternalBDT(){};
 
@@ -29,7 +33,25 @@ public:
   bool LoadModelLibrary(std::string path);
   bool LoadXGBoostModel(std::string path);
 
-  double Predict(double *features, int size, bool useRaw = false);
+  double Predict(const double *features, int size, bool useRaw = false);
+  /// score nRows candidates stored row-major in features (nRows x nCols) into scores (nRows)
+  bool PredictBatch(const float *features, size_t nRows, int nCols, float *scores, bool useRaw = false);
+
+  /// number of worker threads used by the predictor (to be set before loading the model)
+  void SetNThreads(int nThreads) { fNThreads = nThreads > 0 ? nThreads : 1; }
+  int GetNThreads() const { return fNThreads; }
+
+  /// compiler flags profile (-O1, -O3 or -O3 -march=native), to be set before loading the model
+  void SetCompileProfile(int profile) { fCompileProfile = profile; }
+  /// directory shared between jobs where compiled models are stored by content hash.
+  /// If not set the ALIEXTERNALBDT_CACHE environment variable is used, if any.
+  void SetCacheDirectory(std::string dir) { fCacheDir = dir; }
+  std::string GetCompilerFlags() const;
+  /// target options resolved by gcc for -march=native on this host (empty unless kNativeCompile)
+  std::string GetCompilerTarget() const;
+
+  /// hash of the file content combined with salt, as hexadecimal string (empty if the file cannot be read)
+  static std::string HashFile(const std::string &path, const std::string &salt);
 
 private:
   bool CompileAndLoadModelLibrary();
@@ -43,6 +65,10 @@ private:
   std::string fModelName;
   CompilerHandle fCompiler;
   PredictorHandle fPredictor;
+  int fNThreads;              /// number of threads of the treelite predictor
+  int fCompileProfile;        /// compiler flags profile
+  std::string fCacheDir;      /// directory of the compiled model cache
+  std::vector<TreelitePredictorEntry> fEntries; /// buffer for single instance prediction
 };
 
 #endif
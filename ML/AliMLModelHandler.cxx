@@ -26,7 +26,8 @@ ClassImp(AliMLModelHandler);
 /// \endcond
 
 //_______________________________________________________________________________
-AliMLModelHandler::AliMLModelHandler() : TNamed(), fModel{nullptr}, fPath{}, fLibrary{}, fScoreCut{} {
+AliMLModelHandler::AliMLModelHandler()
+    : TNamed(), fModel{nullptr}, fPath{}, fLibrary{}, fCompiledLibrary{}, fLocalPath{}, fScoreCut{} {
   //
   // Default constructor
   //
@@ -35,10 +36,13 @@ AliMLModelHandler::AliMLModelHandler() : TNamed(), fModel{nullptr}, fPath{}, fLi
 //_______________________________________________________________________________
 AliMLModelHandler::AliMLModelHandler(const YAML::Node &node)
     : TNamed(), fModel{nullptr}, fPath{node["path"].as<std::string>()},
-      fLibrary{node["library"].as<std::string>()}, fScoreCut{node["cut"].as<double>()} {
+      fLibrary{node["library"].as<std::string>()}, fCompiledLibrary{}, fLocalPath{},
+      fScoreCut{node["cut"].as<double>()} {
   //
   // Standard constructor
   //
+  if (node["compiled"].IsDefined())
+    fCompiledLibrary = node["compiled"].as<std::string>();
   fModel = new AliExternalBDT();
 }
 
@@ -53,7 +57,8 @@ AliMLModelHandler::~AliMLModelHandler() {
 //_______________________________________________________________________________
 AliMLModelHandler::AliMLModelHandler(const AliMLModelHandler &source)
     : TNamed(source.GetName(), source.GetTitle()), fModel{nullptr}, fPath{source.fPath},
-      fLibrary{source.fLibrary}, fScoreCut{source.fScoreCut} {
+      fLibrary{source.fLibrary}, fCompiledLibrary{source.fCompiledLibrary}, fLocalPath{source.fLocalPath},
+      fScoreCut{source.fScoreCut} {
   //
   // Copy constructor
   //
@@ -74,11 +79,21 @@ AliMLModelHandler &AliMLModelHandler::operator=(const AliMLModelHandler &source)
 
   fPath      = source.fPath;
   fLibrary   = source.fLibrary;
+  fCompiledLibrary = source.fCompiledLibrary;
+  fLocalPath = source.fLocalPath;
   fScoreCut  = source.fScoreCut;
 
   return *this;
 }
 
+//_______________________________________________________________________________
+void AliMLModelHandler::ImportModel() {
+  if (!fCompiledLibrary.empty())
+    fLocalPath = ImportFile(fCompiledLibrary);
+  else
+    fLocalPath = ImportFile(fPath);
+}
+
 //_______________________________________________________________________________
 bool AliMLModelHandler::CompileModel() {
 
@@ -86,7 +101,13 @@ bool AliMLModelHandler::CompileModel() {
                                            {"kLightGBM", AliMLModelHandler::kLightGBM},
                                            {"kModelLibrary", AliMLModelHandler::kModelLibrary}};
 
-  std::string localpath = ImportFile(fPath);
+  if (fLocalPath.empty())
+    ImportModel();
+  std::string localpath = fLocalPath;
+
+  /// a precompiled library shipped with the config is loaded directly
+  if (!fCompiledLibrary.empty())
+    return fModel->LoadModelLibrary(localpath.data());
 
   switch (libraryMap[GetLibrary()]) {
     case kXGBoost: {
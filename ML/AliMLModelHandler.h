@@ -37,8 +37,12 @@ public:
   AliExternalBDT *GetModel() { return fModel; }
   std::string const &GetPath() const { return fPath; }
   std::string const &GetLibrary() const { return fLibrary; }
+  std::string const &GetCompiledLibrary() const { return fCompiledLibrary; }
   double const &GetScoreCut() const { return fScoreCut; }
 
+  /// copy the model (or the precompiled library, if given in the config) to the working directory
+  void ImportModel();
+  /// load the model, ImportModel is called first if not done yet (thread safe after ImportModel)
   bool CompileModel();
   static std::string ImportFile(std::string path);
 
@@ -47,11 +51,13 @@ private:
 
   std::string fPath;       ///
   std::string fLibrary;    ///
+  std::string fCompiledLibrary;    /// optional precompiled model library shipped with the config
+  std::string fLocalPath;          //!<! local path of the imported model
 
   double fScoreCut;        ///
 
 /// \cond CLASSIMP
-ClassDef(AliMLModelHandler, 1);    ///
+ClassDef(AliMLModelHandler, 2);    ///
 /// \endcond
 };
 
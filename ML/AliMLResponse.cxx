@@ -12,6 +12,10 @@
 
 #include "AliMLResponse.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "yaml-cpp/yaml.h"
 
 #include "AliExternalBDT.h"
@@ -29,7 +33,9 @@ ClassImp(AliMLResponse);
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse()
     : TNamed(), fConfigFilePath{}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{}, fNVariables{},
-      fBinsBegin{}, fRaw{} {
+      fBinsBegin{}, fRaw{}, fNThreads{1}, fCompileProfile{0}, fModelCacheDir{}, fNCompileThreads{1},
+      fFeatures{}, fBatchFeatures{}, fBatchScores{}, fBatchIndex{},
+      fBatchBin{}, fBatchBinStart{}, fBatchCursor{} {
   //
   // Default constructor
   //
@@ -38,7 +44,9 @@ AliMLResponse::AliMLResponse()
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse(const Char_t *name, const Char_t *title)
     : TNamed(name, title), fConfigFilePath{""}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{},
-      fNVariables{}, fBinsBegin{}, fRaw{} {
+      fNVariables{}, fBinsBegin{}, fRaw{}, fNThreads{1}, fCompileProfile{0}, fModelCacheDir{}, fNCompileThreads{1},
+      fFeatures{}, fBatchFeatures{}, fBatchScores{}, fBatchIndex{},
+      fBatchBin{}, fBatchBinStart{}, fBatchCursor{} {
   //
   // Standard constructor
   //
@@ -55,10 +63,14 @@ AliMLResponse::~AliMLResponse() {
 AliMLResponse::AliMLResponse(const AliMLResponse &source)
     : TNamed(source.GetName(), source.GetTitle()), fConfigFilePath{source.fConfigFilePath}, fModels{source.fModels},
       fCentClasses{source.fCentClasses}, fBins{source.fBins}, fVariableNames{source.fVariableNames},
-      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin}, fRaw{source.fRaw} {
+      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{}, fRaw{source.fRaw},
+      fNThreads{source.fNThreads}, fCompileProfile{source.fCompileProfile},
+      fModelCacheDir{source.fModelCacheDir}, fNCompileThreads{source.fNCompileThreads}, fFeatures{}, fBatchFeatures{}, fBatchScores{}, fBatchIndex{}, fBatchBin{},
+      fBatchBinStart{}, fBatchCursor{} {
   //
   // Copy constructor
   //
+  fBinsBegin = fBins.begin();
 }
 
 AliMLResponse &AliMLResponse::operator=(const AliMLResponse &source) {
@@ -76,8 +88,12 @@ AliMLResponse &AliMLResponse::operator=(const AliMLResponse &source) {
   fVariableNames  = source.fVariableNames;
   fNBins          = source.fNBins;
   fNVariables     = source.fNVariables;
-  fBinsBegin      = source.fBinsBegin;
+  fBinsBegin      = fBins.begin();
   fRaw            = source.fRaw;
+  fNThreads       = source.fNThreads;
+  fCompileProfile = source.fCompileProfile;
+  fModelCacheDir  = source.fModelCacheDir;
+  fNCompileThreads = source.fNCompileThreads;
 
   return *this;
 }
@@ -124,9 +140,31 @@ void AliMLResponse::CompileModels(std::string configLocalPath) {
     fModels.push_back(AliMLModelHandler{model});
   }
 
+  /// files are imported sequentially (TFile::Cp is not thread safe), then models are compiled in parallel
   for (auto &model : fModels) {
-    bool comp = model.CompileModel();
-    if (!comp) {
+    model.ImportModel();
+    model.GetModel()->SetNThreads(fNThreads);
+    model.GetModel()->SetCompileProfile(fCompileProfile);
+    if (!fModelCacheDir.empty())
+      model.GetModel()->SetCacheDirectory(fModelCacheDir);
+  }
+
+  int nModels = fModels.size();
+  int nThreads = fNCompileThreads > 0 ? fNCompileThreads : 1;
+  vector<char> compiled(nModels, 0);
+  std::atomic<int> nextModel{0};
+  auto compileWorker = [&]() {
+    for (int iModel = nextModel++; iModel < nModels; iModel = nextModel++) {
+      compiled[iModel] = fModels[iModel].CompileModel();
+    }
+  };
+  vector<std::thread> workers;
+  for (int iThread = 1; iThread < std::min(nThreads, nModels); ++iThread) workers.emplace_back(compileWorker);
+  compileWorker();
+  for (auto &worker : workers) worker.join();
+
+  for (int iModel = 0; iModel < nModels; ++iModel) {
+    if (!compiled[iModel]) {
       AliFatal("Error in model compilation! Exit");
     }
   }
@@ -151,28 +189,37 @@ int AliMLResponse::FindBin(double binvar) {
 }
 
 //_______________________________________________________________________________
-double AliMLResponse::Predict(double binvar, map<string, double> varmap) {
+int AliMLResponse::GetFeatureIndex(const string &varname) const {
+  for (int iVar = 0; iVar < (int)fVariableNames.size(); ++iVar) {
+    if (fVariableNames[iVar] == varname) return iVar;
+  }
+  return -1;
+}
+
+//_______________________________________________________________________________
+double AliMLResponse::Predict(double binvar, const map<string, double> &varmap) {
   if ((int)varmap.size() < fNVariables) {
     AliFatal("The variable map you provided to the predictor has a size smaller than the variable list size! Exit");
   }
 
-  vector<double> features;
-  for (const auto &varname : fVariableNames) {
-    if (varmap.find(varname) == varmap.end()) {
-      AliFatal(Form("Variable |%s| not found in variable list provided in config! Exit", varname.data()));
+  fFeatures.resize(fNVariables);
+  for (int iVar = 0; iVar < fNVariables; ++iVar) {
+    map<string, double>::const_iterator var = varmap.find(fVariableNames[iVar]);
+    if (var == varmap.end()) {
+      AliFatal(Form("Variable |%s| not found in variable list provided in config! Exit", fVariableNames[iVar].data()));
     }
-    features.push_back(varmap[varname]);
+    fFeatures[iVar] = var->second;
   }
 
   int bin = FindBin(binvar);
   if (bin < 0)
     return -999.;
 
-  return fModels.at(bin - 1).GetModel()->Predict(&features[0], fNVariables, fRaw);
+  return fModels.at(bin - 1).GetModel()->Predict(&fFeatures[0], fNVariables, fRaw);
 }
 
 //_______________________________________________________________________________
-double AliMLResponse::Predict(double binvar, vector<double> variables) {
+double AliMLResponse::Predict(double binvar, const vector<double> &variables) {
   if ((int)variables.size() != fNVariables) {
     AliFatal(Form("Number of variables passed (%d) different from the one used in the model (%d)! Exit",
                   (int)variables.size(), fNVariables));
@@ -186,13 +233,65 @@ double AliMLResponse::Predict(double binvar, vector<double> variables) {
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelected(double binvar, std::map<std::string, double> varmap) {
+void AliMLResponse::PredictBatch(const double *binvars, const float *features, int ncand, double *scores) {
+  /// counting sort of the candidates by model bin, bin 0 collects the candidates outside the binning
+  int nModels = fModels.size();
+  fBatchBin.resize(ncand);
+  fBatchBinStart.assign(nModels + 2, 0);
+  for (int iCand = 0; iCand < ncand; ++iCand) {
+    int bin = std::lower_bound(fBins.begin(), fBins.end(), binvars[iCand]) - fBins.begin();
+    if (bin == fNBins) bin = 0;
+    fBatchBin[iCand] = bin;
+    fBatchBinStart[bin + 1]++;
+  }
+  for (int iBin = 0; iBin <= nModels; ++iBin) fBatchBinStart[iBin + 1] += fBatchBinStart[iBin];
+  fBatchCursor.assign(fBatchBinStart.begin(), fBatchBinStart.end() - 1);
+  fBatchIndex.resize(ncand);
+  for (int iCand = 0; iCand < ncand; ++iCand) fBatchIndex[fBatchCursor[fBatchBin[iCand]]++] = iCand;
+
+  for (int iPos = fBatchBinStart[0]; iPos < fBatchBinStart[1]; ++iPos) scores[fBatchIndex[iPos]] = -999.;
+
+  for (int iBin = 1; iBin <= nModels; ++iBin) {
+    int first = fBatchBinStart[iBin];
+    int nInBin = fBatchBinStart[iBin + 1] - first;
+    if (nInBin == 0) continue;
+    /// gather the rows of this bin in a contiguous block
+    fBatchFeatures.resize((size_t)nInBin * fNVariables);
+    for (int iPos = 0; iPos < nInBin; ++iPos) {
+      const float *row = features + (size_t)fBatchIndex[first + iPos] * fNVariables;
+      std::copy(row, row + fNVariables, fBatchFeatures.begin() + (size_t)iPos * fNVariables);
+    }
+    fBatchScores.resize(nInBin);
+    if (!fModels[iBin - 1].GetModel()->PredictBatch(fBatchFeatures.data(), nInBin, fNVariables, fBatchScores.data(), fRaw)) {
+      AliFatal("Error in batch prediction! Exit");
+    }
+    for (int iPos = 0; iPos < nInBin; ++iPos) scores[fBatchIndex[first + iPos]] = fBatchScores[iPos];
+  }
+}
+
+//_______________________________________________________________________________
+void AliMLResponse::IsSelectedBatch(const double *binvars, const float *features, int ncand, bool *selected,
+                                    double *scores) {
+  vector<double> localScores;
+  if (!scores) {
+    localScores.resize(ncand);
+    scores = localScores.data();
+  }
+  PredictBatch(binvars, features, ncand, scores);
+  for (int iCand = 0; iCand < ncand; ++iCand) {
+    int bin = fBatchBin[iCand];
+    selected[iCand] = (bin > 0) ? scores[iCand] >= fModels[bin - 1].GetScoreCut() : false;
+  }
+}
+
+//_______________________________________________________________________________
+bool AliMLResponse::IsSelected(double binvar, const std::map<std::string, double> &varmap) {
   double score{0.};
   return IsSelected(binvar, varmap, score);
 }
 
 //_______________________________________________________________________________
-bool AliMLResponse::IsSelected(double binvar, std::vector<double> variables) {
+bool AliMLResponse::IsSelected(double binvar, const std::vector<double> &variables) {
   double score{0.};
   return IsSelected(binvar, variables, score);
 }
\ No newline at end of file
@@ -46,20 +46,40 @@ public:
   void CompileModels(std::string configLocalPath);     /// (it has to be done run time)
   void MLResponseInit();    /// (it has to be done run time)
 
+  /// number of threads used by the predictors in batch mode (to be set before MLResponseInit)
+  void SetNThreads(int nthreads) { fNThreads = nthreads; }
+  /// compiler flags profile of the models, see AliExternalBDT (to be set before MLResponseInit)
+  void SetCompileProfile(int profile) { fCompileProfile = profile; }
+  /// directory of the compiled model cache shared between jobs (to be set before MLResponseInit)
+  void SetModelCacheDirectory(std::string dir) { fModelCacheDir = dir; }
+  /// maximum number of models compiled in parallel (default 1: sequential compilation)
+  void SetNCompileThreads(int nthreads) { fNCompileThreads = nthreads; }
+
   /// return the bin index
   int FindBin(double binvar);
+  /// return the position of a feature in the rows passed to the batch methods (-1 if not used by the models)
+  int GetFeatureIndex(const std::string &varname) const;
+  /// return the number of features (columns) expected by the batch methods
+  int GetNFeatures() const { return fNVariables; }
   /// return the ML model predicted score (raw or proba, depending on useraw)
-  double Predict(double binvar, std::map<std::string, double> varmap);
+  double Predict(double binvar, const std::map<std::string, double> &varmap);
   /// overload to pass directly a vector of variables
-  double Predict(double binvar, std::vector<double> variables);
+  double Predict(double binvar, const std::vector<double> &variables);
   /// return true if predicted score for map is above the threshold given in the config
-  bool IsSelected(double binvar, std::map<std::string, double> varmap);
+  bool IsSelected(double binvar, const std::map<std::string, double> &varmap);
   /// overload for getting the model score too
-  template <typename F> bool IsSelected(double binvar, std::map<std::string, double> varmap, F &score);
+  template <typename F> bool IsSelected(double binvar, const std::map<std::string, double> &varmap, F &score);
   /// overload to pass directly a vector of variables
-  bool IsSelected(double binvar, std::vector<double> variables);
+  bool IsSelected(double binvar, const std::vector<double> &variables);
   /// overload for getting the model score too
-  template <typename F> bool IsSelected(double binvar, std::vector<double> variables, F &score);
+  template <typename F> bool IsSelected(double binvar, const std::vector<double> &variables, F &score);
+
+  /// batch prediction: features is a row-major matrix (ncand x GetNFeatures()) with columns ordered
+  /// as given by GetFeatureIndex, candidates are grouped by model bin and scored in one call per bin.
+  /// Candidates outside the binning get a score of -999.
+  void PredictBatch(const double *binvars, const float *features, int ncand, double *scores);
+  /// batch selection, optionally returning the scores
+  void IsSelectedBatch(const double *binvars, const float *features, int ncand, bool *selected, double *scores = nullptr);
 
 protected:
   std::string fConfigFilePath;    /// path of the config file
@@ -75,13 +95,25 @@ protected:
   std::vector<float>::iterator fBinsBegin;    //!<!  evaluate just once is better
 
   bool fRaw;    /// set to true to use raw score instead of probability
+  int fNThreads;    /// number of threads of the treelite predictors
+  int fCompileProfile;          /// compiler flags profile of the models
+  std::string fModelCacheDir;   /// directory of the compiled model cache
+  int fNCompileThreads;         /// maximum number of models compiled in parallel
+
+  std::vector<double> fFeatures;       //!<! buffer for single candidate features
+  std::vector<float> fBatchFeatures;   //!<! buffer for features of the candidates in one bin
+  std::vector<float> fBatchScores;     //!<! buffer for scores of the candidates in one bin
+  std::vector<int> fBatchIndex;        //!<! candidate indices sorted by bin
+  std::vector<int> fBatchBin;          //!<! model bin of each candidate (0 if outside the binning)
+  std::vector<int> fBatchBinStart;     //!<! first position in fBatchIndex for each bin
+  std::vector<int> fBatchCursor;       //!<! fill position in fBatchIndex for each bin
 
   /// \cond CLASSIMP
-  ClassDef(AliMLResponse, 2);    ///
+  ClassDef(AliMLResponse, 3);    ///
   /// \endcond
 };
 
-template <typename F> bool AliMLResponse::IsSelected(double binvar, std::map<std::string, double> varmap, F &score) {
+template <typename F> bool AliMLResponse::IsSelected(double binvar, const std::map<std::string, double> &varmap, F &score) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return false;
@@ -89,7 +121,7 @@ template <typename F> bool AliMLResponse::IsSelected(double binvar, std::map<std
   return score >= fModels.at(bin - 1).GetScoreCut();
 }
 
-template <typename F> bool AliMLResponse::IsSelected(double binvar, std::vector<double> variables, F &score) {
+template <typename F> bool AliMLResponse::IsSelected(double binvar, const std::vector<double> &variables, F &score) {
   int bin = FindBin(binvar);
   if (bin < 0)
     return false;
@@ -130,6 +130,41 @@ Bool_t AliEmcalCorrectionCellBadChannel::Run()
   return kTRUE;
 }
 
+/**
+ * The bad channel removal can be executed in a single pass with the other cell corrections
+ * if no QA histograms are requested.
+ */
+Bool_t AliEmcalCorrectionCellBadChannel::IsCellCorrectionFusable() const
+{
+  return !fCreateHisto;
+}
+
+/**
+ * Same as Run(), but the bad channel mask is tabulated for the fused cell corrections
+ * instead of being applied to the cells.
+ */
+Bool_t AliEmcalCorrectionCellBadChannel::PrepareCellCorrection()
+{
+  AliEmcalCorrectionComponent::Run();
+
+  if (!fEventManager.InputEvent()) {
+    AliError("Event ptr = 0, returning");
+    return kFALSE;
+  }
+
+  CheckIfRunChanged();
+
+  fRecoUtils->SwitchOnBadChannelsRemoval();
+
+  if (fCaloCells->GetNumberOfCells()<=0)
+  {
+    AliWarning(Form("Number of EMCAL cells = %d, returning", fCaloCells->GetNumberOfCells()));
+    return kFALSE;
+  }
+
+  return UpdateCellCalibrationTable();
+}
+
 /**
  * This function is called if the run changes (it inherits from the base component),
  * to load a new bad channel and fill relevant variables.
@@ -0,0 +1,110 @@
+// AliEmcalCorrectionCellCalibrationTable
+//
+
+#include "AliEmcalCorrectionCellCalibrationTable.h"
+
+#include <AliAODCaloCells.h>
+#include <AliEMCALGeometry.h>
+#include <AliEMCALRecoUtils.h>
+#include <AliLog.h>
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalCorrectionCellCalibrationTable);
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliEmcalCorrectionCellCalibrationTable::AliEmcalCorrectionCellCalibrationTable():
+  fRun(-1),
+  fParIndex(-1),
+  fIdentity(kTRUE),
+  fNTimeSlots(1),
+  fAccept(),
+  fEnergyFactor(),
+  fTimeOffset()
+{
+}
+
+/**
+ * Invalidate the table, such that it is filled again at the next use.
+ */
+void AliEmcalCorrectionCellCalibrationTable::Reset()
+{
+  fRun = -1;
+  fParIndex = -1;
+  fIdentity = kTRUE;
+  fNTimeSlots = 1;
+  fAccept.clear();
+  fEnergyFactor.clear();
+  fTimeOffset.clear();
+}
+
+/**
+ * Fill the table from the current configuration of the reco utils. Each cell is probed with
+ * AliEMCALRecoUtils::AcceptCalibrateCell() using a unit energy and zero time, so that the
+ * calibrated values are the energy factor and the time offset of the cell.
+ *
+ * Note that the reco utils must be configured (switches, calibration maps, PAR number) for the
+ * current run before calling this function.
+ *
+ * @param[in] recoUtils Reco utils used by the component
+ * @param[in] geom EMCal geometry of the run
+ * @param[in] run Run number for which the table is filled
+ * @param[in] parIndex PAR index for which the table is filled
+ *
+ * @return True if the table was filled successfully
+ */
+Bool_t AliEmcalCorrectionCellCalibrationTable::Fill(AliEMCALRecoUtils * recoUtils, AliEMCALGeometry * geom, Int_t run, Short_t parIndex)
+{
+  Reset();
+  if (!recoUtils || !geom) {
+    AliErrorGeneral("AliEmcalCorrectionCellCalibrationTable", "Reco utils or geometry not available, cannot fill the calibration table");
+    return kFALSE;
+  }
+
+  fRun = run;
+  fParIndex = parIndex;
+
+  // Same condition as in AliEMCALRecoUtils::RecalibrateCells()
+  fIdentity = !recoUtils->IsRecalibrationOn() && !recoUtils->IsTimeRecalibrationOn() && !recoUtils->IsBadChannelsRemovalSwitchedOn();
+  if (fIdentity) return kTRUE;
+
+  // The time offset only depends on the bunch crossing and the gain if the time is recalibrated
+  fNTimeSlots = (recoUtils->IsTimeRecalibrationOn() || recoUtils->IsL1PhaseInTimeRecalibrationOn()) ? kNTimeSlots : 1;
+
+  const Int_t nCells = geom->GetNCells();
+  fAccept.assign(nCells, 0);
+  fEnergyFactor.assign(nCells, 0.);
+  fTimeOffset.assign(nCells * fNTimeSlots, 0.);
+
+  AliAODCaloCells probe("probeCells", "probeCells", AliVCaloCells::kEMCALCell);
+  probe.CreateContainer(1);
+
+  recoUtils->ResetCellsCalibrated();
+  Float_t amp = 0;
+  Double_t time = 0;
+  for (Int_t absId = 0; absId < nCells; absId++) {
+    probe.SetCell(0, absId, 1., 0., -1, 0., kTRUE);
+    if (!recoUtils->AcceptCalibrateCell(absId, 0, amp, time, &probe)) continue;
+
+    fAccept[absId] = 1;
+    fEnergyFactor[absId] = amp;
+    if (fNTimeSlots == 1) {
+      fTimeOffset[absId] = time;
+      continue;
+    }
+
+    for (Int_t gain = 0; gain < 2; gain++) {
+      const Bool_t highGain = (gain == 0);
+      probe.SetCell(0, absId, 1., 0., -1, 0., highGain);
+      // bc = -1 is the case without bunch crossing information
+      for (Int_t bunchCrossNo = -1; bunchCrossNo < 4; bunchCrossNo++) {
+        recoUtils->AcceptCalibrateCell(absId, bunchCrossNo, amp, time, &probe);
+        fTimeOffset[absId * fNTimeSlots + GetTimeSlot(bunchCrossNo, highGain)] = time;
+      }
+    }
+  }
+
+  return kTRUE;
+}
@@ -0,0 +1,90 @@
+#ifndef ALIEMCALCORRECTIONCELLCALIBRATIONTABLE_H
+#define ALIEMCALCORRECTIONCELLCALIBRATIONTABLE_H
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class AliEMCALGeometry;
+class AliEMCALRecoUtils;
+
+/**
+ * @class AliEmcalCorrectionCellCalibrationTable
+ * @ingroup EMCALCORRECTIONFW
+ * @brief Flat per-run cell calibration table used for the fused cell corrections
+ *
+ * Contains the result of AliEMCALRecoUtils::AcceptCalibrateCell() for every cell of the detector,
+ * stored in contiguous arrays indexed by the absolute cell ID: the bad channel mask, the energy
+ * recalibration factor, and the time offset for each bunch crossing class (bc%4, or no bunch crossing
+ * information) and gain. The table is filled once per run (and PAR period) by probing the configured
+ * reco utils, such that applying the calibration to a cell only requires array reads.
+ *
+ * Applying the table gives the same result as AliEMCALRecoUtils::RecalibrateCells(), except for the
+ * cell time, where the offsets are summed before being applied, and thus may differ at the level of the
+ * floating point precision. The tower shaper non-linearity correction is not linear in the cell energy and
+ * therefore cannot be tabulated.
+ *
+ * See AliEmcalCorrectionTask::SetFuseCellCorrections() for the use of the table.
+ */
+
+class AliEmcalCorrectionCellCalibrationTable {
+ public:
+  AliEmcalCorrectionCellCalibrationTable();
+  virtual ~AliEmcalCorrectionCellCalibrationTable() {}
+
+  /// True if the table was filled for the given run and PAR index
+  Bool_t IsValid(Int_t run, Short_t parIndex) const { return fRun == run && fParIndex == parIndex; }
+  /// True if the reco utils do not modify the cells
+  Bool_t IsIdentity() const { return fIdentity; }
+  void Reset();
+  Bool_t Fill(AliEMCALRecoUtils * recoUtils, AliEMCALGeometry * geom, Int_t run, Short_t parIndex);
+
+  inline void Apply(Int_t absId, Int_t bunchCrossNo, Bool_t highGain, Double_t & energy, Double_t & time) const;
+
+ protected:
+  /// Number of time offset slots per cell: 4 bunch crossing classes and no bunch crossing, times two gains
+  static const Int_t kNTimeSlots = 10;
+  /// Index of the time offset slot for the bunch crossing and gain
+  static Int_t GetTimeSlot(Int_t bunchCrossNo, Bool_t highGain) { return 2 * ((bunchCrossNo >= 0) ? bunchCrossNo % 4 : 4) + (highGain ? 0 : 1); }
+
+  Int_t                   fRun;                           ///< Run for which the table is filled
+  Short_t                 fParIndex;                      ///< PAR index for which the table is filled
+  Bool_t                  fIdentity;                      ///< True if the cells are not modified
+  Int_t                   fNTimeSlots;                    ///< Number of time offsets per cell (1 if independent of bunch crossing and gain)
+  std::vector<Char_t>     fAccept;                        ///< Cell is accepted (not bad and existing), by absId
+  std::vector<Float_t>    fEnergyFactor;                  ///< Energy recalibration factor, by absId
+  std::vector<Double_t>   fTimeOffset;                    ///< Time offset, by absId * fNTimeSlots + slot
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalCorrectionCellCalibrationTable, 1); // EMCal flat cell calibration table
+  /// \endcond
+};
+
+/**
+ * Apply the tabulated calibration to a cell. Rejected cells are set to zero energy and a time of -1,
+ * as in AliEMCALRecoUtils::RecalibrateCells().
+ *
+ * @param[in] absId Absolute ID of the cell
+ * @param[in] bunchCrossNo Bunch crossing number of the event
+ * @param[in] highGain True if the cell is high gain
+ * @param[in,out] energy Cell energy
+ * @param[in,out] time Cell time
+ */
+void AliEmcalCorrectionCellCalibrationTable::Apply(Int_t absId, Int_t bunchCrossNo, Bool_t highGain, Double_t & energy, Double_t & time) const
+{
+  if (fIdentity) return;
+
+  if (absId < 0 || absId >= static_cast<Int_t>(fAccept.size()) || !fAccept[absId]) {
+    energy = 0;
+    time = -1;
+    return;
+  }
+
+  // The reco utils calibrate the energy in single precision
+  Float_t amp = energy;
+  amp *= fEnergyFactor[absId];
+  energy = amp;
+  time += fTimeOffset[absId * fNTimeSlots + ((fNTimeSlots > 1) ? GetTimeSlot(bunchCrossNo, highGain) : 0)];
+}
+
+#endif /* ALIEMCALCORRECTIONCELLCALIBRATIONTABLE_H */
@@ -141,6 +141,47 @@ Bool_t AliEmcalCorrectionCellEnergy::Run()
   return kTRUE;
 }
 
+/**
+ * The energy recalibration can be executed in a single pass with the other cell corrections
+ * if no QA histograms are requested. The shaper non-linearity correction is not a per cell
+ * factor, so it requires the standard execution.
+ */
+Bool_t AliEmcalCorrectionCellEnergy::IsCellCorrectionFusable() const
+{
+  return !fCreateHisto && !fUseShaperCorrection;
+}
+
+/**
+ * Same as Run(), but the recalibration factors are tabulated for the fused cell corrections
+ * instead of being applied to the cells.
+ */
+Bool_t AliEmcalCorrectionCellEnergy::PrepareCellCorrection()
+{
+  AliEmcalCorrectionComponent::Run();
+
+  if (!fEventManager.InputEvent()) {
+    AliError("Event ptr = 0, returning");
+    return kFALSE;
+  }
+
+  CheckIfRunChanged();
+
+  fRecoUtils->SwitchOnRecalibration();
+
+  if (fCaloCells->GetNumberOfCells()<=0)
+  {
+    AliDebug(2, Form("Number of EMCAL cells = %d, returning", fCaloCells->GetNumberOfCells()));
+    return kFALSE;
+  }
+
+  Bool_t ready = UpdateCellCalibrationTable();
+
+  // switch off recalibrations as in Run()
+  fRecoUtils->SwitchOffRecalibration();
+
+  return ready;
+}
+
 /**
  * Initialize the energy calibration.
  */
@@ -124,6 +124,30 @@ Bool_t AliEmcalCorrectionCellEnergyVariation::Run()
   return kTRUE;
 }
 
+/**
+ * Per event setup for the fused cell corrections.
+ * @return True if an energy scale function is available
+ */
+Bool_t AliEmcalCorrectionCellEnergyVariation::PrepareCellCorrection()
+{
+  AliEmcalCorrectionComponent::Run();
+
+  return fEnergyScaleFunction != 0;
+}
+
+/**
+ * Scale the energy of a single cell as in Run().
+ */
+void AliEmcalCorrectionCellEnergyVariation::CorrectCell(Short_t /*absId*/, Bool_t /*highGain*/, Double_t & energy, Double_t & /*time*/) const
+{
+  if (energy > fMinCellE && energy < fMaxCellE) {
+    Double_t scaledEnergy = energy * fEnergyScaleFunction->Eval(energy);
+    if (scaledEnergy > 0.) {
+      energy = scaledEnergy;
+    }
+  }
+}
+
 /**
  * Load the energy scale function TF1 from a file into the member fEnergyScaleFunction
  * @param path Path to the file containing the TF1
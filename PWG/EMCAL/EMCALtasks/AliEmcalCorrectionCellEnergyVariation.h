@@ -30,6 +30,11 @@ class AliEmcalCorrectionCellEnergyVariation : public AliEmcalCorrectionComponent
   void UserCreateOutputObjects();
   void ExecOnce();
   Bool_t Run();
+
+  // Fused cell corrections
+  Bool_t IsCellCorrectionFusable() const { return kTRUE; }
+  Bool_t PrepareCellCorrection();
+  void CorrectCell(Short_t absId, Bool_t highGain, Double_t & energy, Double_t & time) const;
   
 protected:
   
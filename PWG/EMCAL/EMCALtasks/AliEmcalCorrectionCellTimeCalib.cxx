@@ -489,6 +489,49 @@ Int_t AliEmcalCorrectionCellTimeCalib::InitTimeCalibrationL1Phase()
   return 1;
 }
 
+/**
+ * The time calibration can be executed in a single pass with the other cell corrections
+ * if no QA histograms are requested.
+ */
+Bool_t AliEmcalCorrectionCellTimeCalib::IsCellCorrectionFusable() const
+{
+  return !fCreateHisto;
+}
+
+/**
+ * Same as Run(), but the time offsets are tabulated for the fused cell corrections
+ * instead of being applied to the cells.
+ */
+Bool_t AliEmcalCorrectionCellTimeCalib::PrepareCellCorrection()
+{
+  AliEmcalCorrectionComponent::Run();
+
+  if (!fEventManager.InputEvent()) {
+    AliError("Event ptr = 0, returning");
+    return kFALSE;
+  }
+
+  CheckIfRunChanged();
+
+  if (fCalibrateTime)
+    fRecoUtils->SwitchOnTimeRecalibration();
+  else
+    fRecoUtils->SwitchOffTimeRecalibration();
+
+  if (fCalibrateTimeL1Phase)
+    fRecoUtils->SwitchOnL1PhaseInTimeRecalibration();
+  else
+    fRecoUtils->SwitchOffL1PhaseInTimeRecalibration();
+
+  if (fCaloCells->GetNumberOfCells()<=0)
+  {
+    AliWarning(Form("Number of EMCAL cells = %d, returning", fCaloCells->GetNumberOfCells()));
+    return kFALSE;
+  }
+
+  return UpdateCellCalibrationTable();
+}
+
 /**
  * This function is called if the run changes (it inherits from the base component),
  * to load a new time calibration and fill relevant variables.
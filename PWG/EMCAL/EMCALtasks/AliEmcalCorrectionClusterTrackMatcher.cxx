@@ -3,8 +3,12 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <algorithm>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -38,6 +42,7 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseOuterParamInESDs(kFALSE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseClusterGrid(kTRUE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fEmcalTracks(0),
@@ -46,6 +51,15 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
+  fGridEtaMin(0),
+  fGridEtaCellSize(0),
+  fGridPhiCellSize(0),
+  fGridNEta(0),
+  fGridNPhi(0),
+  fGridCellStart(),
+  fGridClusters(),
+  fGridUnbinned(),
+  fGridCandidates(),
   fNMCGenerToAccept(0),
   fMCGenerToAcceptForTrack(1)
 {
@@ -82,6 +96,7 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("useClusterGrid", fUseClusterGrid);
   fDoPropagation = fEsdMode;
   
   Bool_t enableFracEMCRecalc = kFALSE;
@@ -365,50 +380,161 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 
 /**
  * Set the links between tracks and clusters.
+ * With fUseClusterGrid each track is only tested against the clusters in the neighbouring cells of
+ * an eta-phi grid. The candidates are tested in increasing cluster index, i.e. in the same order
+ * as in the loop over all clusters, so that the matched objects and distances are identical.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  if (fUseClusterGrid && BuildClusterGrid()) {
+    for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
+      AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
+      GetGridCandidates(emcalTrack->GetTrack(), fGridCandidates);
+      for (std::vector<Int_t>::const_iterator it = fGridCandidates.begin(); it != fGridCandidates.end(); ++it) {
+        MatchPair(itrack, emcalTrack, *it, maxd2);
+      }
+    }
+    return;
+  }
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
-    AliVTrack* track = emcalTrack->GetTrack();
-
     for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
-      AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
-      AliVCluster* cluster = emcalCluster->GetCluster();
-      
-      Double_t deta = 999;
-      Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
-      Double_t d2 = deta * deta + dphi * dphi;
+      MatchPair(itrack, emcalTrack, icluster, maxd2);
+    }
+  }
+}
 
-      if (d2 > maxd2) continue;
-      
-      Double_t d = TMath::Sqrt(d2);
-      emcalCluster->AddMatchedObj(itrack, d);
-      emcalTrack->AddMatchedObj(icluster, d);
-      AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
-                       "with track pT = %.3f, eta = %.3f, phi = %.3f"
-                       "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
-                       cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
-                       emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
-                       track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
-      
-      if (fCreateHisto) {
-        Int_t mombin = GetMomBin(track->P());
-        Int_t centbinch = fCentBin;
-        if (track->Charge() < 0) centbinch += fNcentBins;
-        Int_t etabin = 0;
-        if(track->Eta() > 0) etabin = 1;
-
-        fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
-        fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
-        fHistMatchEtaAll->Fill(deta);
-        fHistMatchPhiAll->Fill(dphi);
+/**
+ * Test a track-cluster pair and set the link if the distance is below fMaxDistance.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::MatchPair(Int_t itrack, AliEmcalParticle* emcalTrack, Int_t icluster, Double_t maxd2)
+{
+  AliVTrack* track = emcalTrack->GetTrack();
+  AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+  AliVCluster* cluster = emcalCluster->GetCluster();
+
+  Double_t deta = 999;
+  Double_t dphi = 999;
+  GetEtaPhiDiff(track, cluster, dphi, deta);
+  Double_t d2 = deta * deta + dphi * dphi;
+
+  if (d2 > maxd2) return;
+
+  Double_t d = TMath::Sqrt(d2);
+  emcalCluster->AddMatchedObj(itrack, d);
+  emcalTrack->AddMatchedObj(icluster, d);
+  AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
+                   "with track pT = %.3f, eta = %.3f, phi = %.3f"
+                   "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
+                   cluster->GetNonLinCorrEnergy(), emcalCluster->Pt(), emcalCluster->Eta(), emcalCluster->Phi(),
+                   emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi(),
+                   track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), d));
+
+  if (fCreateHisto) {
+    Int_t mombin = GetMomBin(track->P());
+    Int_t centbinch = fCentBin;
+    if (track->Charge() < 0) centbinch += fNcentBins;
+    Int_t etabin = 0;
+    if(track->Eta() > 0) etabin = 1;
+
+    fHistMatchEta[centbinch][mombin][etabin]->Fill(deta);
+    fHistMatchPhi[centbinch][mombin][etabin]->Fill(dphi);
+    fHistMatchEtaAll->Fill(deta);
+    fHistMatchPhiAll->Fill(dphi);
+  }
+}
+
+/**
+ * Fill the clusters of the event into an eta-phi grid (positions as in GetEtaPhiDiff).
+ * The cell size is slightly larger than fMaxDistance, therefore a cluster within fMaxDistance
+ * of a track is always in the same or in a neighbouring cell.
+ * @return False if the grid cannot be used (no clusters or matching distance too large)
+ */
+Bool_t AliEmcalCorrectionClusterTrackMatcher::BuildClusterGrid()
+{
+  if (fNEmcalClusters <= 0 || !(fMaxDistance > 0)) return kFALSE;
+
+  fGridEtaCellSize = fMaxDistance * (1 + 1e-3);
+  fGridNPhi = TMath::FloorNint(TMath::TwoPi() / fGridEtaCellSize);
+  if (fGridNPhi < 3) return kFALSE;
+  fGridPhiCellSize = TMath::TwoPi() / fGridNPhi;
+
+  // Cluster positions
+  std::vector<Int_t> cell(fNEmcalClusters, -1);
+  std::vector<Double_t> eta(fNEmcalClusters, 0);
+  std::vector<Double_t> phi(fNEmcalClusters, 0);
+  fGridUnbinned.clear();
+  Double_t etaMax = 0;
+  Bool_t first = kTRUE;
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    eta[icluster] = cpos.Eta();
+    phi[icluster] = cpos.Phi();
+    if (!TMath::Finite(eta[icluster]) || !TMath::Finite(phi[icluster])) {
+      fGridUnbinned.push_back(icluster);
+      continue;
+    }
+    if (first || eta[icluster] < fGridEtaMin) fGridEtaMin = eta[icluster];
+    if (first || eta[icluster] > etaMax) etaMax = eta[icluster];
+    first = kFALSE;
+  }
+  fGridNEta = first ? 0 : TMath::FloorNint((etaMax - fGridEtaMin) / fGridEtaCellSize) + 1;
+
+  // Counting sort of the clusters into the cells, ascending cluster index within a cell
+  const Int_t ncells = fGridNEta * fGridNPhi;
+  fGridCellStart.assign(ncells + 1, 0);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (!TMath::Finite(eta[icluster]) || !TMath::Finite(phi[icluster])) continue;
+    Int_t ieta = TMath::Min(fGridNEta - 1, TMath::FloorNint((eta[icluster] - fGridEtaMin) / fGridEtaCellSize));
+    Double_t p = TVector2::Phi_0_2pi(phi[icluster]);
+    Int_t iphi = TMath::Min(fGridNPhi - 1, TMath::FloorNint(p / fGridPhiCellSize));
+    cell[icluster] = ieta * fGridNPhi + iphi;
+    fGridCellStart[cell[icluster] + 1]++;
+  }
+  for (Int_t i = 0; i < ncells; i++) fGridCellStart[i + 1] += fGridCellStart[i];
+  fGridClusters.resize(fGridCellStart[ncells]);
+  std::vector<Int_t> fill(fGridCellStart.begin(), fGridCellStart.end() - 1);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (cell[icluster] >= 0) fGridClusters[fill[cell[icluster]]++] = icluster;
+  }
+
+  return kTRUE;
+}
+
+/**
+ * Clusters which can be within fMaxDistance of the track position on the EMCal surface, in increasing index.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::GetGridCandidates(const AliVTrack* track, std::vector<Int_t>& candidates) const
+{
+  candidates.assign(fGridUnbinned.begin(), fGridUnbinned.end());
+
+  const Double_t veta = track->GetTrackEtaOnEMCal();
+  const Double_t vphi = track->GetTrackPhiOnEMCal();
+  if (!TMath::Finite(veta) || !TMath::Finite(vphi)) {
+    // no sensible position, test all clusters as without the grid
+    candidates.resize(fNEmcalClusters);
+    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) candidates[icluster] = icluster;
+    return;
+  }
+
+  const Double_t etaPos = (veta - fGridEtaMin) / fGridEtaCellSize;
+  if (etaPos >= -1 && etaPos < fGridNEta + 1) {
+    const Int_t ieta = TMath::FloorNint(etaPos);
+    const Int_t iphi = TMath::Min(fGridNPhi - 1, TMath::FloorNint(TVector2::Phi_0_2pi(vphi) / fGridPhiCellSize));
+    for (Int_t ie = TMath::Max(0, ieta - 1); ie <= TMath::Min(fGridNEta - 1, ieta + 1); ie++) {
+      for (Int_t dp = -1; dp <= 1; dp++) {
+        const Int_t c = ie * fGridNPhi + (iphi + dp + fGridNPhi) % fGridNPhi;
+        candidates.insert(candidates.end(), fGridClusters.begin() + fGridCellStart[c], fGridClusters.begin() + fGridCellStart[c + 1]);
       }
     }
   }
+  std::sort(candidates.begin(), candidates.end());
 }
 
 /**
@@ -3,6 +3,8 @@
 
 #include "AliEmcalCorrectionComponent.h"
 
+#include <vector>
+
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 #include "AliEmcalContainerIndexMap.h"
 #endif
@@ -11,6 +13,7 @@ class TH1;
 class TClonesArray;
 
 class AliVParticle;
+class AliEmcalParticle;
 
 /**
  * @class AliEmcalCorrectionClusterTrackMatcher
@@ -69,6 +72,9 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          MatchPair(Int_t itrack, AliEmcalParticle* emcalTrack, Int_t icluster, Double_t maxd2);
+  Bool_t        BuildClusterGrid();
+  void          GetGridCandidates(const AliVTrack* track, std::vector<Int_t>& candidates) const;
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -88,6 +94,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Bool_t        fUseOuterParamInESDs;   ///< Use TPC outer parameters instead of inner parameters for track propagation, ESDs only
   Bool_t        fUpdateTracks;          ///< update tracks with matching info
   Bool_t        fUpdateClusters;        ///< update clusters with matching info
+  Bool_t        fUseClusterGrid;        ///< test tracks only against clusters in neighbouring eta-phi cells (same result as testing all clusters)
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
@@ -103,6 +110,17 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!<!dphi distribution
+
+  // Eta-phi grid of the clusters of the current event, cell size slightly larger than fMaxDistance
+  Double_t      fGridEtaMin;            //!<!lower eta edge of the grid
+  Double_t      fGridEtaCellSize;       //!<!cell size in eta
+  Double_t      fGridPhiCellSize;       //!<!cell size in phi (2pi / number of phi cells)
+  Int_t         fGridNEta;              //!<!number of cells in eta
+  Int_t         fGridNPhi;              //!<!number of cells in phi
+  std::vector<Int_t> fGridCellStart;    //!<!first entry in fGridClusters for each cell (cell = ieta * fGridNPhi + iphi), size ncells+1
+  std::vector<Int_t> fGridClusters;     //!<!cluster indices sorted by cell
+  std::vector<Int_t> fGridUnbinned;     //!<!clusters without a valid position, tested against every track
+  std::vector<Int_t> fGridCandidates;   //!<!candidate clusters of the current track
   
   Int_t      fNMCGenerToAccept;          ///<  Number of MC generators that should not be included in analysis
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
@@ -116,7 +134,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 6); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -52,7 +52,9 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fRecoUtils(0),
   fOutput(0),
   fBasePath(""),
-  fCustomBadChannelFilePath("")
+  fCustomBadChannelFilePath(""),
+  fCellCalibrationTable(),
+  fCellCalibrationBunchCrossNo(0)
 
 {
   fVertex[0] = 0;
@@ -88,7 +90,9 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fRecoUtils(0),
   fOutput(0),
   fBasePath(""),
-  fCustomBadChannelFilePath("")
+  fCustomBadChannelFilePath(""),
+  fCellCalibrationTable(),
+  fCellCalibrationBunchCrossNo(0)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -209,24 +213,74 @@ void AliEmcalCorrectionComponent::UpdateCells()
   Int_t bunchCrossNo = fEventManager.InputEvent()->GetBunchCrossNumber();
   
   if (fRecoUtils){
-    //In case of PAR run check global event ID
-    if(fRecoUtils->IsParRun()){
-      Short_t currentParIndex = 0;
-      ULong64_t globalEventID = (ULong64_t)bunchCrossNo + (ULong64_t)fEventManager.InputEvent()->GetOrbitNumber() * (ULong64_t)3564 + (ULong64_t)fEventManager.InputEvent()->GetPeriodNumber() * (ULong64_t)59793994260;
-      for(Short_t ipar=0;ipar<fRecoUtils->GetNPars();ipar++){
-	if(globalEventID >= fRecoUtils->GetGlobalIDPar(ipar)) {
-	  currentParIndex++;
-	}
-      }
-      fRecoUtils->SetCurrentParNumber(currentParIndex);      
-    }
-    //end of PAR run settings
+    UpdateCurrentParNumber(bunchCrossNo);
 
     fRecoUtils->RecalibrateCells(fCaloCells, bunchCrossNo);
   }
   fCaloCells->Sort();
 }
 
+/**
+ * In case of a PAR run, determine the PAR index of the event from the global event ID
+ * and set it in the reco utils.
+ *
+ * @param[in] bunchCrossNo Bunch crossing number of the event
+ * @return The current PAR index of the reco utils
+ */
+Short_t AliEmcalCorrectionComponent::UpdateCurrentParNumber(Int_t bunchCrossNo)
+{
+  //In case of PAR run check global event ID
+  if(fRecoUtils->IsParRun()){
+    Short_t currentParIndex = 0;
+    ULong64_t globalEventID = (ULong64_t)bunchCrossNo + (ULong64_t)fEventManager.InputEvent()->GetOrbitNumber() * (ULong64_t)3564 + (ULong64_t)fEventManager.InputEvent()->GetPeriodNumber() * (ULong64_t)59793994260;
+    for(Short_t ipar=0;ipar<fRecoUtils->GetNPars();ipar++){
+      if(globalEventID >= fRecoUtils->GetGlobalIDPar(ipar)) {
+        currentParIndex++;
+      }
+    }
+    fRecoUtils->SetCurrentParNumber(currentParIndex);
+  }
+  //end of PAR run settings
+  return fRecoUtils->GetCurrentParNumber();
+}
+
+/**
+ * Fused counterpart of UpdateCells(): instead of recalibrating the cells, the calibration of the
+ * reco utils is tabulated by absId (once per run and PAR period), to be applied to each cell with
+ * CorrectCell(). The reco utils must be configured as for UpdateCells().
+ *
+ * @return True if the calibration table is ready to be applied
+ */
+Bool_t AliEmcalCorrectionComponent::UpdateCellCalibrationTable()
+{
+  if (!fEventManager.InputEvent() || !fRecoUtils) return kFALSE;
+
+  fCellCalibrationBunchCrossNo = fEventManager.InputEvent()->GetBunchCrossNumber();
+  Short_t currentParIndex = UpdateCurrentParNumber(fCellCalibrationBunchCrossNo);
+
+  if (!fCellCalibrationTable.IsValid(fRun, currentParIndex)) {
+    AliDebugStream(1) << GetName() << ": filling cell calibration table for run " << fRun << ", PAR index " << currentParIndex << "\n";
+    if (!fCellCalibrationTable.Fill(fRecoUtils, fGeom, fRun, currentParIndex)) return kFALSE;
+  }
+  // The table replaces the recalibration of the cells
+  fRecoUtils->ResetCellsCalibrated();
+  return kTRUE;
+}
+
+/**
+ * Apply the correction of the component to a single cell. By default, the tabulated
+ * reco utils calibration prepared with UpdateCellCalibrationTable() is applied.
+ *
+ * @param[in] absId Absolute ID of the cell
+ * @param[in] highGain True if the cell is high gain
+ * @param[in,out] energy Cell energy
+ * @param[in,out] time Cell time
+ */
+void AliEmcalCorrectionComponent::CorrectCell(Short_t absId, Bool_t highGain, Double_t & energy, Double_t & time) const
+{
+  fCellCalibrationTable.Apply(absId, fCellCalibrationBunchCrossNo, highGain, energy, time);
+}
+
 /**
  * Check whether the run changed.
  */
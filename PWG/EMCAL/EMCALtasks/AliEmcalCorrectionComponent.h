@@ -22,6 +22,7 @@ class AliVEvent;
 #include "AliTrackContainer.h"
 #include "AliClusterContainer.h"
 #include "AliEmcalCorrectionEventManager.h"
+#include "AliEmcalCorrectionCellCalibrationTable.h"
 
 /**
  * @class AliEmcalCorrectionComponent
@@ -53,9 +54,17 @@ class AliEmcalCorrectionComponent : public TNamed {
   virtual Bool_t Run();
   virtual Bool_t UserNotify();
   virtual Bool_t CheckIfRunChanged();
+
+  // Fused cell corrections, see AliEmcalCorrectionTask::SetFuseCellCorrections()
+  /// True if the component only modifies each cell independently and can be executed in a single pass with other cell components
+  virtual Bool_t IsCellCorrectionFusable() const { return kFALSE; }
+  /// Per event setup of the fused cell correction. Returns true if CorrectCell() should be applied to the cells of this event.
+  virtual Bool_t PrepareCellCorrection() { return kFALSE; }
+  virtual void CorrectCell(Short_t absId, Bool_t highGain, Double_t & energy, Double_t & time) const;
   
   void GetEtaPhiDiff(const AliVTrack *t, const AliVCluster *v, Double_t &phidiff, Double_t &etadiff);
   void UpdateCells();
+  Bool_t UpdateCellCalibrationTable();
   void GetPass();
   void FillCellQA(TH1F* h);
   Int_t InitBadChannels();
@@ -110,6 +119,8 @@ class AliEmcalCorrectionComponent : public TNamed {
   /// Retrieve property
   template<typename T> bool GetProperty(std::string propertyName, T & property, bool requiredProperty = true, std::string correctionName = "");
  protected:
+  Short_t UpdateCurrentParNumber(Int_t bunchCrossNo);
+
   PWG::Tools::AliYAMLConfiguration fYAMLConfig;           ///< Contains the %YAML configuration used to configure the component
   Bool_t                  fCreateHisto;                   ///< Flag to make some basic histograms
   Bool_t                  fLoad1DBadChMap;                ///< Flag to load 1D bad channel map
@@ -137,12 +148,15 @@ class AliEmcalCorrectionComponent : public TNamed {
   TString                fBasePath;                       ///< Base folder path to get root files
   TString                fCustomBadChannelFilePath;       ///< Custom path to bad channel map OADB file
 
+  AliEmcalCorrectionCellCalibrationTable fCellCalibrationTable; //!<! Tabulated reco utils cell calibration for the fused cell corrections
+  Int_t                  fCellCalibrationBunchCrossNo;    //!<! Bunch crossing number of the event for the fused cell corrections
+
  private:
   AliEmcalCorrectionComponent(const AliEmcalCorrectionComponent &);               // Not implemented
   AliEmcalCorrectionComponent &operator=(const AliEmcalCorrectionComponent &);    // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionComponent, 9); // EMCal correction component
+  ClassDef(AliEmcalCorrectionComponent, 10); // EMCal correction component
   /// \endcond
 };
 
@@ -46,6 +46,9 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fOrderedComponentsToExecute(),
   fCorrectionComponents(),
   fConfigurationInitialized(false),
+  fFuseCellCorrections(kFALSE),
+  fFusedCellChainLength(),
+  fActiveCellStages(),
   fIsEsd(false),
   fEventInitialized(false),
   fCent(0),
@@ -91,6 +94,9 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fOrderedComponentsToExecute(),
   fCorrectionComponents(),
   fConfigurationInitialized(false),
+  fFuseCellCorrections(kFALSE),
+  fFusedCellChainLength(),
+  fActiveCellStages(),
   fIsEsd(false),
   fEventInitialized(false),
   fCent(0),
@@ -136,6 +142,9 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fOrderedComponentsToExecute(task.fOrderedComponentsToExecute),
   fCorrectionComponents(task.fCorrectionComponents),  // TODO: These should be copied!
   fConfigurationInitialized(task.fConfigurationInitialized),
+  fFuseCellCorrections(task.fFuseCellCorrections),
+  fFusedCellChainLength(task.fFusedCellChainLength),
+  fActiveCellStages(),
   fIsEsd(task.fIsEsd),
   fEventInitialized(task.fEventInitialized),
   fCent(task.fCent),
@@ -199,6 +208,9 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fOrderedComponentsToExecute, second.fOrderedComponentsToExecute);
   swap(first.fCorrectionComponents, second.fCorrectionComponents);
   swap(first.fConfigurationInitialized, second.fConfigurationInitialized);
+  swap(first.fFuseCellCorrections, second.fFuseCellCorrections);
+  swap(first.fFusedCellChainLength, second.fFusedCellChainLength);
+  swap(first.fActiveCellStages, second.fActiveCellStages);
   swap(first.fIsEsd, second.fIsEsd);
   swap(first.fEventInitialized, second.fEventInitialized);
   swap(first.fCent, second.fCent);
@@ -271,6 +283,13 @@ void AliEmcalCorrectionTask::Initialize(bool removeDummyTask)
     AliFatal("YAML configuration must be initialized before running (ie. in the run macro or wagon)!");
   }
 
+  // Single pass execution of the cell corrections. It is also enabled if it was requested with SetFuseCellCorrections()
+  bool fuseCellCorrections = false;
+  fYAMLConfig.GetProperty("fuseCellCorrections", fuseCellCorrections, false);
+  if (fuseCellCorrections) {
+    fFuseCellCorrections = kTRUE;
+  }
+
   // Determine component execution order
   DetermineComponentsToExecute(fOrderedComponentsToExecute);
 
@@ -1172,6 +1191,7 @@ void AliEmcalCorrectionTask::ExecOnce()
 
   // Setup the components
   ExecOnceComponents();
+  CompileFusedCellCorrections();
 }
 
 /**
@@ -1206,6 +1226,42 @@ void AliEmcalCorrectionTask::ExecOnceComponents()
   }
 }
 
+/**
+ * Determine the sequences of consecutive cell components which can be executed in a single pass over
+ * the cells (see SetFuseCellCorrections()). A sequence requires at least two components which can be
+ * fused and which operate on the same cells. All other components are executed as usual.
+ */
+void AliEmcalCorrectionTask::CompileFusedCellCorrections()
+{
+  fFusedCellChainLength.assign(fCorrectionComponents.size(), 1);
+  if (!fFuseCellCorrections) return;
+
+  std::size_t first = 0;
+  while (first < fCorrectionComponents.size())
+  {
+    AliVCaloCells * cells = fCorrectionComponents.at(first)->GetCaloCells();
+    std::size_t last = first;
+    while (cells && last < fCorrectionComponents.size() &&
+        fCorrectionComponents.at(last)->IsCellCorrectionFusable() &&
+        fCorrectionComponents.at(last)->GetCaloCells() == cells)
+    {
+      last++;
+    }
+
+    if (last - first > 1) {
+      fFusedCellChainLength.at(first) = last - first;
+      std::stringstream stages;
+      for (std::size_t i = first; i < last; i++)
+      {
+        if (i > first) { fFusedCellChainLength.at(i) = 0; stages << ", "; }
+        stages << fCorrectionComponents.at(i)->GetName();
+      }
+      AliInfoStream() << "Executing cell corrections in a single pass over cells \"" << cells->GetName() << "\": " << stages.str() << "\n";
+    }
+    first = (last > first) ? last : first + 1;
+  }
+}
+
 /**
  * Retrieve objects from event.
  * @return
@@ -1306,15 +1362,20 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
 Bool_t AliEmcalCorrectionTask::Run()
 {
   // Run the initialization for all derived classes.
-  for (auto component : fCorrectionComponents)
+  std::size_t i = 0;
+  while (i < fCorrectionComponents.size())
   {
-    component->SetInputEvent(InputEvent());
-    component->SetMCEvent(MCEvent());
-    component->SetCentralityBin(fCentBin);
-    component->SetCentrality(fCent);
-    component->SetVertex(fVertex);
+    std::size_t nFused = (i < fFusedCellChainLength.size()) ? fFusedCellChainLength[i] : 1;
+    if (nFused > 1) {
+      RunFusedCellCorrections(i, nFused);
+      i += nFused;
+      continue;
+    }
 
+    AliEmcalCorrectionComponent * component = fCorrectionComponents[i];
+    SetupComponentForEvent(component);
     component->Run();
+    i++;
   }
 
   PostData(1, fOutput);
@@ -1322,6 +1383,68 @@ Bool_t AliEmcalCorrectionTask::Run()
   return kTRUE;
 }
 
+/**
+ * Set the event properties of a component before it is executed.
+ */
+void AliEmcalCorrectionTask::SetupComponentForEvent(AliEmcalCorrectionComponent * component)
+{
+  component->SetInputEvent(InputEvent());
+  component->SetMCEvent(MCEvent());
+  component->SetCentralityBin(fCentBin);
+  component->SetCentrality(fCent);
+  component->SetVertex(fVertex);
+}
+
+/**
+ * Execute a sequence of fused cell components (see CompileFusedCellCorrections()). The per event
+ * setup of each component is performed first, then each cell is read, corrected by all components
+ * in order, and written back once. The cells are sorted once at the end, as done by the reco utils
+ * based components.
+ *
+ * @param[in] firstComponent Index of the first component of the sequence
+ * @param[in] nComponents Number of components in the sequence
+ */
+void AliEmcalCorrectionTask::RunFusedCellCorrections(std::size_t firstComponent, std::size_t nComponents)
+{
+  fActiveCellStages.clear();
+  bool sortCells = false;
+  for (std::size_t i = firstComponent; i < firstComponent + nComponents; i++)
+  {
+    AliEmcalCorrectionComponent * component = fCorrectionComponents[i];
+    SetupComponentForEvent(component);
+    if (component->PrepareCellCorrection()) {
+      fActiveCellStages.push_back(component);
+      if (component->GetRecoUtils()) sortCells = true;
+    }
+  }
+  if (fActiveCellStages.empty()) return;
+
+  AliVCaloCells * cells = fActiveCellStages.front()->GetCaloCells();
+  Short_t absId = -1;
+  Double_t energy = 0;
+  Double_t time = 0;
+  Double_t efrac = 0;
+  Int_t mclabel = -1;
+  const Int_t nCells = cells->GetNumberOfCells();
+  for (Int_t iCell = 0; iCell < nCells; iCell++)
+  {
+    if (!cells->GetCell(iCell, absId, energy, time, mclabel, efrac)) {
+      AliWarning(TString::Format("Could not get cell %i from cell collection %s", iCell, cells->GetName()));
+    }
+    // NOTE: GetCellHighGain() uses the cell position, not cell index
+    Bool_t highGain = cells->GetHighGain(iCell);
+
+    for (auto stage : fActiveCellStages)
+    {
+      stage->CorrectCell(absId, highGain, energy, time);
+    }
+
+    cells->SetCell(iCell, absId, energy, time, mclabel, efrac, highGain);
+  }
+
+  if (sortCells) cells->Sort();
+}
+
 /**
  * Executed when the file is changed. Also calls UserNotify() for each component.
  */
@@ -1754,6 +1877,9 @@ std::string AliEmcalCorrectionTask::toString(bool includeYAMLConfigurationInfo)
   for (auto component : fOrderedComponentsToExecute) {
     tempSS << "\t" << component << "\n";
   }
+  if (fFuseCellCorrections) {
+    tempSS << "Cell corrections are executed in a single pass where possible\n";
+  }
   // Input objects
   tempSS << "\nInput objects:\n";
   PrintRequestedContainersInformation(AliEmcalContainerUtils::kCaloCells, tempSS);
@@ -100,6 +100,13 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom     = b                              ; }
+  /**
+   * Execute consecutive cell correction components which operate on the same cells in a single pass over
+   * the cells. The reco utils based calibrations are then applied from per-run tables indexed by absId.
+   * Components which fill QA histograms, or which need neighbouring cells (e.g. the crosstalk emulation),
+   * are executed separately. Can also be enabled with "fuseCellCorrections" in the %YAML configuration.
+   */
+  void                        SetFuseCellCorrections(Bool_t b = kTRUE)              { fFuseCellCorrections = b                            ; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
@@ -191,6 +198,9 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Execute component functions
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
+  void CompileFusedCellCorrections();
+  void RunFusedCellCorrections(std::size_t firstComponent, std::size_t nComponents);
+  void SetupComponentForEvent(AliEmcalCorrectionComponent * component);
 
   // Initialization functions
   void InitializeConfiguration();
@@ -225,6 +235,9 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   std::vector <std::string>   fOrderedComponentsToExecute; ///< Ordered set of components to execute
   std::vector <AliEmcalCorrectionComponent *> fCorrectionComponents; ///< Contains the correction components
   bool                        fConfigurationInitialized;   ///< True if the %YAML configuration files are initialized
+  Bool_t                      fFuseCellCorrections;        ///< Execute consecutive cell components in a single pass over the cells
+  std::vector <std::size_t>   fFusedCellChainLength;       //!<! Number of components executed in a single cell pass starting at each component (0 if part of a previous pass)
+  std::vector <AliEmcalCorrectionComponent *> fActiveCellStages; //!<! Components applied in the current cell pass
 
   bool                        fIsEsd;                      ///< File type
   bool                        fEventInitialized;           ///< If the event is initialized properly
@@ -249,7 +262,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TList *                     fOutput;                     //!<! Output for histograms
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 9); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 10); // EMCal correction task
   /// \endcond
 };
 
@@ -43,6 +43,7 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithQCumulants.h"
+#include "AliFlowQVectorEngine.h"
 #include "TArrayD.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -134,9 +135,11 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
+ fUseQVectorEngine(kFALSE),
  fReQ(NULL),
  fImQ(NULL),
  fSpk(NULL),
+ fQVectorEngine(NULL),
  fIntFlowCorrelationsEBE(NULL),
  fIntFlowEventWeightsForCorrelationsEBE(NULL),
  fIntFlowCorrelationsAllEBE(NULL),
@@ -271,6 +274,7 @@ AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
  // destructor
  
  delete fHistList;
+ delete fQVectorEngine;
 
 } // end of AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
 
@@ -409,23 +413,29 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      wTrack = aftsTrack->Weight(); 
     }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+    if(fQVectorEngine) // Q_{m*n,k} and S_{p,k} are calculated from all RPs after the loop over data:
     {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
+     fQVectorEngine->AddTrack(dPhi,wPhi*wPt*wEta*wTrack);
+    } else
+      {
+       // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
+       for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+       {
+        for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+        {
+         (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
+         (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
+        } 
+       }
+       // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
+       for(Int_t p=0;p<8;p++)
+       {
+        for(Int_t k=0;k<9;k++)
+        {     
+         (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
+        }
+       }
+      } // end of else of if(fQVectorEngine)
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
@@ -548,6 +558,13 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
+ // Q_{m*n,k} and S_{p,k} from the (phi, weight) arrays of all RPs (equal to the per-track calculation up to rounding):
+ if(fQVectorEngine)
+ {
+  fQVectorEngine->Fill(n,fReQ,fImQ,fSpk);
+  fQVectorEngine->Reset();
+ }
+
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
  {
@@ -1773,6 +1790,8 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForIntegratedFlow()
  fReQ = new TMatrixD(12,9);
  fImQ = new TMatrixD(12,9);
  fSpk = new TMatrixD(8,9);
+ // (phi, weight) arrays of RPs from which Q_{m*n,k} and S_{p,k} are calculated at the end of the loop over data:
+ if(fUseQVectorEngine){fQVectorEngine = new AliFlowQVectorEngine();}
  // average correlations <2>, <4>, <6> and <8> for single event (bining is the same as in fIntFlowCorrelationsPro and fIntFlowCorrelationsHist):
  TString intFlowCorrelationsEBEName = "fIntFlowCorrelationsEBE";
  intFlowCorrelationsEBEName += fAnalysisLabel->Data();
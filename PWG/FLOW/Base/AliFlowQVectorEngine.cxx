@@ -0,0 +1,165 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include <cstdio>
+#include "AliFlowQVectorEngine.h"
+#include "TMatrixD.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowQVectorEngine:                                             *
+// Accumulates the event-by-event Q-vectors and sums of weights from *
+// (phi, weight) arrays, see header for details.                     *
+//********************************************************************
+
+ClassImp(AliFlowQVectorEngine)
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::AliFlowQVectorEngine():
+  TObject(),
+  fNTracks(0),
+  fPhi(),
+  fWeight()
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::~AliFlowQVectorEngine()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::AddTrack(Double_t phi, Double_t weight)
+{
+  // add one track, arrays grow to the largest multiplicity seen and are then reused
+
+  if(fNTracks >= (Int_t)fPhi.size())
+  {
+    fPhi.resize(fNTracks+256);
+    fWeight.resize(fNTracks+256);
+  }
+  fPhi[fNTracks] = phi;
+  fWeight[fNTracks] = weight;
+  fNTracks++;
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::Fill(Int_t harmonic, Int_t nHarmonics, Int_t nPowers, Double_t *reQ, Double_t *imQ, Double_t *s) const
+{
+  // Add the sums over the tracks of the current event to reQ[m*nPowers+k], imQ[m*nPowers+k]
+  // (harmonic (m+1)*n) and s[k]. Per block of tracks:
+  // a) cos(n*phi) and sin(n*phi) are evaluated once per track;
+  // b) w^k is built by successive multiplication;
+  // c) cos((m+1)*n*phi) and sin((m+1)*n*phi) follow from multiplication with exp(i*n*phi).
+  // The result agrees with the direct evaluation up to rounding (relative ~1e-14).
+
+  if(nHarmonics > kMaxHarmonics || nPowers > kMaxPowers)
+  {
+    printf("\n WARNING (AliFlowQVectorEngine::Fill): at most %d harmonics and %d powers are supported !!!!\n\n",kMaxHarmonics,kMaxPowers);
+    if(nHarmonics > kMaxHarmonics){nHarmonics = kMaxHarmonics;}
+    if(nPowers > kMaxPowers){nPowers = kMaxPowers;}
+  }
+
+  Double_t cos1[kBlock], sin1[kBlock]; // cos(n*phi), sin(n*phi)
+  Double_t cosM[kBlock], sinM[kBlock]; // cos((m+1)*n*phi), sin((m+1)*n*phi)
+  Double_t wk[kMaxPowers][kBlock]; // w^k
+  for(Int_t first=0;first<fNTracks;first+=kBlock)
+  {
+    const Int_t nb = (fNTracks-first < kBlock) ? fNTracks-first : kBlock;
+    const Double_t *phi = &fPhi[first];
+    const Double_t *w = &fWeight[first];
+    for(Int_t i=0;i<nb;i++)
+    {
+     cos1[i] = TMath::Cos(harmonic*phi[i]);
+     sin1[i] = TMath::Sin(harmonic*phi[i]);
+     cosM[i] = cos1[i];
+     sinM[i] = sin1[i];
+     wk[0][i] = 1.;
+    }
+    for(Int_t k=1;k<nPowers;k++)
+    {
+     for(Int_t i=0;i<nb;i++){wk[k][i] = wk[k-1][i]*w[i];}
+    }
+    if(s)
+    {
+     for(Int_t k=0;k<nPowers;k++)
+     {
+      Double_t sum = 0.;
+      for(Int_t i=0;i<nb;i++){sum += wk[k][i];}
+      s[k] += sum;
+     }
+    }
+    for(Int_t m=0;m<nHarmonics;m++)
+    {
+     if(m>0)
+     {
+      for(Int_t i=0;i<nb;i++)
+      {
+       const Double_t c = cosM[i]*cos1[i]-sinM[i]*sin1[i];
+       sinM[i] = sinM[i]*cos1[i]+cosM[i]*sin1[i];
+       cosM[i] = c;
+      }
+     }
+     for(Int_t k=0;k<nPowers;k++)
+     {
+      Double_t re = 0., im = 0.;
+      for(Int_t i=0;i<nb;i++)
+      {
+       re += wk[k][i]*cosM[i];
+       im += wk[k][i]*sinM[i];
+      }
+      reQ[m*nPowers+k] += re;
+      imQ[m*nPowers+k] += im;
+     }
+    }
+  } // end of for(Int_t first=0;first<fNTracks;first+=kBlock)
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::Fill(Int_t harmonic, TMatrixD *reQ, TMatrixD *imQ, TMatrixD *spk) const
+{
+  // add the Q-vectors to reQ(m,k) and imQ(m,k) and the sums of weights to each row of spk(p,k)
+
+  if(!reQ || !imQ){return;}
+  const Int_t nHarmonics = TMath::Min(reQ->GetNrows(),(Int_t)kMaxHarmonics);
+  const Int_t nPowers = TMath::Min(reQ->GetNcols(),(Int_t)kMaxPowers);
+  Double_t re[kMaxHarmonics*kMaxPowers] = {0.};
+  Double_t im[kMaxHarmonics*kMaxPowers] = {0.};
+  Double_t s[kMaxPowers] = {0.};
+  Fill(harmonic,nHarmonics,nPowers,re,im,s);
+  for(Int_t m=0;m<nHarmonics;m++)
+  {
+   for(Int_t k=0;k<nPowers;k++)
+   {
+    (*reQ)(m,k) += re[m*nPowers+k];
+    (*imQ)(m,k) += im[m*nPowers+k];
+   }
+  }
+  if(spk)
+  {
+   const Int_t nPowersS = TMath::Min(spk->GetNcols(),nPowers);
+   for(Int_t p=0;p<spk->GetNrows();p++)
+   {
+    for(Int_t k=0;k<nPowersS;k++){(*spk)(p,k) += s[k];}
+   }
+  }
+}
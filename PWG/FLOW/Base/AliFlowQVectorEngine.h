@@ -0,0 +1,55 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORENGINE_H
+#define ALIFLOWQVECTORENGINE_H
+
+#include <vector>
+#include "TObject.h"
+
+class TMatrixD;
+
+//********************************************************************
+// AliFlowQVectorEngine:                                             *
+// Accumulates the event-by-event Q-vectors                          *
+//   Re[Q_{m*n,k}] = sum_i w_i^k cos(m*n*phi_i)                      *
+//   Im[Q_{m*n,k}] = sum_i w_i^k sin(m*n*phi_i)                      *
+// and the sums of weights s_{k} = sum_i w_i^k from (phi, weight)    *
+// arrays. Only cos(n*phi) and sin(n*phi) are evaluated per track,   *
+// higher harmonics follow from complex multiplication and the       *
+// weight powers are built incrementally. Tracks are processed in    *
+// blocks so that the inner loops run over contiguous arrays.        *
+//********************************************************************
+
+class AliFlowQVectorEngine: public TObject {
+ public:
+  AliFlowQVectorEngine();
+  virtual ~AliFlowQVectorEngine();
+
+  void Reset() {fNTracks = 0;};                   // forget the tracks of the current event (storage is kept)
+  void AddTrack(Double_t phi, Double_t weight);   // add one track of the current event
+  Int_t GetNTracks() const {return fNTracks;};
+  const Double_t* GetPhi() const {return fNTracks > 0 ? &fPhi[0] : 0;};
+  const Double_t* GetWeight() const {return fNTracks > 0 ? &fWeight[0] : 0;};
+
+  // adds Re[Q_{(m+1)*n,k}], Im[Q_{(m+1)*n,k}] to reQ(m,k), imQ(m,k) and s_{k} to
+  // every row p of spk(p,k) (spk can be NULL); matrices define the number of harmonics and powers
+  void Fill(Int_t harmonic, TMatrixD *reQ, TMatrixD *imQ, TMatrixD *spk) const;
+  // same for plain arrays [nHarmonics][nPowers] and [nPowers]
+  void Fill(Int_t harmonic, Int_t nHarmonics, Int_t nPowers, Double_t *reQ, Double_t *imQ, Double_t *s) const;
+
+  enum {kBlock = 16, kMaxHarmonics = 16, kMaxPowers = 16};
+
+ private:
+  AliFlowQVectorEngine(const AliFlowQVectorEngine& engine);
+  AliFlowQVectorEngine& operator=(const AliFlowQVectorEngine& engine);
+
+  Int_t fNTracks;                  // number of tracks of the current event
+  std::vector<Double_t> fPhi;      //! azimuthal angles
+  std::vector<Double_t> fWeight;   //! total weights (phi x pt x eta x track)
+
+  ClassDef(AliFlowQVectorEngine,1) // Q-vector accumulation from (phi, weight) arrays
+};
+
+#endif
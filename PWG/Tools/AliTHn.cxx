@@ -360,6 +360,38 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::AddBinContents(Int_t istep, Int_t n, const Long64_t* bins, const Double_t* values, const Double_t* sumw2)
+{
+  // adds pre-accumulated contents to n bins (global bin index as in GetGlobalBinIndex, starting at 0)
+  // sumw2 contains the sum of the squared weights per bin, 0 means that all entries had weight 1
+  // equivalent to calling Fill for each of the single entries
+  
+  if (!fValues[istep])
+  {
+    fValues[istep] = new TemplateArray(fNBins);
+    AliInfo(Form("Created values container for step %d", istep));
+  }
+
+  if (sumw2 && !fSumw2[istep])
+  {
+    // see Fill
+    fSumw2[istep] = new TemplateArray(*fValues[istep]);
+    AliInfo(Form("Created sumw2 container for step %d", istep));
+  }
+  
+  TemplateType* target = fValues[istep]->GetArray();
+  for (Int_t i=0; i<n; i++)
+    target[bins[i]] += values[i];
+  
+  if (fSumw2[istep])
+  {
+    target = fSumw2[istep]->GetArray();
+    for (Int_t i=0; i<n; i++)
+      target[bins[i]] += (sumw2) ? sumw2[i] : values[i];
+  }
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -26,6 +26,7 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void AddBinContents(Int_t istep, Int_t n, const Long64_t* bins, const Double_t* values, const Double_t* sumw2) = 0;
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,6 +49,7 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void AddBinContents(Int_t istep, Int_t n, const Long64_t* bins, const Double_t* values, const Double_t* sumw2);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
@@ -0,0 +1,212 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// two-track efficiency (merging) cut on the minimal dphi* between the trigger and the associated particles
+// see header file for details
+
+#include "AliTwoTrackMergingCut.h"
+
+#include <algorithm>
+#include "TObjArray.h"
+#include "TArrayF.h"
+#include "AliVParticle.h"
+
+namespace
+{
+  // bending constant: 0.3 * B(0.5 T) / 2, radius in m, pt in GeV/c
+  const Float_t kBend = 0.075;
+
+  // step of the radius scan which was used before, the bisection stops at this resolution
+  const Float_t kRadiusResolution = 0.01;
+
+  struct EtaLess
+  {
+    EtaLess(const TArrayF& eta) : fEta(eta) {}
+    bool operator()(Int_t a, Int_t b) const { return fEta[a] < fEta[b]; }
+    const TArrayF& fEta;
+  };
+}
+
+//____________________________________________________________________
+AliTwoTrackMergingCut::AliTwoTrackMergingCut(Float_t cutValue, Float_t minRadius, Float_t maxRadius) :
+  fCutValue(cutValue),
+  fMinRadius(minRadius),
+  fMaxRadius(maxRadius),
+  fBSign(0),
+  fEta(),
+  fIndex(),
+  fPhi(),
+  fPt(),
+  fCharge(),
+  fQB(),
+  fBendMin(),
+  fBendMax(),
+  fDPhiStarMin(),
+  fMark(),
+  fTag(0)
+{
+  // Constructor
+}
+
+//____________________________________________________________________
+Float_t AliTwoTrackMergingCut::Fold(Float_t dphistar)
+{
+  // folding of dphi* as in AliUEHistograms::GetDPhiStar
+
+  static const Double_t kPi = TMath::Pi();
+
+  if (dphistar > kPi)
+    dphistar = kPi * 2 - dphistar;
+  if (dphistar < -kPi)
+    dphistar = -kPi * 2 - dphistar;
+  if (dphistar > kPi) // might look funny but is needed
+    dphistar = kPi * 2 - dphistar;
+
+  return dphistar;
+}
+
+//____________________________________________________________________
+Float_t AliTwoTrackMergingCut::DPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign)
+{
+  //
+  // calculates dphistar
+  //
+
+  return Fold(phi1 - phi2 - charge1 * bSign * TMath::ASin(kBend * radius / pt1) + charge2 * bSign * TMath::ASin(kBend * radius / pt2));
+}
+
+//____________________________________________________________________
+Float_t AliTwoTrackMergingCut::Solve(Float_t dphi, Float_t qb1, Float_t k1, Float_t qb2, Float_t k2, Float_t rLow, Float_t rHigh, Float_t dLow, Float_t dHigh)
+{
+  // dphi* changes sign between rLow and rHigh: bisection down to the resolution of the former scan,
+  // returns the boundary value of the final interval with the smaller |dphi*|
+
+  while (rHigh - rLow > kRadiusResolution)
+  {
+    Float_t r = 0.5 * (rLow + rHigh);
+    Float_t d = Fold(dphi - qb1 * TMath::ASin(k1 * r) + qb2 * TMath::ASin(k2 * r));
+    if (d * dLow > 0)
+    {
+      rLow = r;
+      dLow = d;
+    }
+    else
+    {
+      rHigh = r;
+      dHigh = d;
+    }
+  }
+
+  return (TMath::Abs(dLow) < TMath::Abs(dHigh)) ? dLow : dHigh;
+}
+
+//____________________________________________________________________
+void AliTwoTrackMergingCut::SetAssociated(TObjArray* particles, const TArrayF& eta, Float_t bSign)
+{
+  // caches the kinematics of the associated particles and sorts them in eta
+  // the bending at the minimal and maximal radius are calculated once per particle
+
+  fBSign = bSign;
+
+  Int_t n = particles->GetEntriesFast();
+  fIndex.resize(n);
+  fEta.resize(n);
+  fPhi.resize(n);
+  fPt.resize(n);
+  fCharge.resize(n);
+  fQB.resize(n);
+  fBendMin.resize(n);
+  fBendMax.resize(n);
+  fDPhiStarMin.resize(n);
+  fMark.assign(n, 0);
+  fTag = 0;
+
+  for (Int_t j=0; j<n; j++)
+  {
+    AliVParticle* particle = (AliVParticle*) particles->UncheckedAt(j);
+
+    fIndex[j] = j;
+    fPhi[j] = particle->Phi();
+    fPt[j] = particle->Pt();
+    fCharge[j] = particle->Charge();
+    fQB[j] = fCharge[j] * bSign;
+    fBendMin[j] = TMath::ASin(kBend * fMinRadius / fPt[j]);
+    // flagged with -1 when the track curls up before fMaxRadius
+    fBendMax[j] = (fPt[j] >= kBend * fMaxRadius) ? TMath::ASin(kBend * fMaxRadius / fPt[j]) : -1;
+  }
+
+  std::sort(fIndex.begin(), fIndex.end(), EtaLess(eta));
+  for (Int_t j=0; j<n; j++)
+    fEta[j] = eta[fIndex[j]];
+}
+
+//____________________________________________________________________
+Int_t AliTwoTrackMergingCut::ProcessTrigger(Float_t eta, Float_t phi, Float_t pt, Float_t charge, Int_t skip)
+{
+  // marks the associated particles which form a close pair with this trigger particle and stores their dphi*_min
+  // same preselection as before: |deta| < 7.5 * cut and |dphi*| < 3 * cut at one of the boundaries or a sign change in between
+  // returns the number of close pairs
+
+  fTag++;
+
+  const Float_t kEtaWindow = fCutValue * 2.5 * 3;
+  const Float_t kLimit = fCutValue * 3;
+
+  const Float_t qb1 = charge * fBSign;
+  const Bool_t curls1 = (pt < kBend * fMaxRadius);
+  const Float_t bendMin1 = TMath::ASin(kBend * fMinRadius / pt);
+  const Float_t bendMax1 = (curls1) ? 0 : TMath::ASin(kBend * fMaxRadius / pt);
+
+  Int_t nClose = 0;
+  std::vector<Float_t>::const_iterator first = std::upper_bound(fEta.begin(), fEta.end(), eta - kEtaWindow);
+  for (Int_t s = first - fEta.begin(); s < (Int_t) fEta.size() && fEta[s] < eta + kEtaWindow; s++)
+  {
+    Int_t j = fIndex[s];
+    if (j == skip)
+      continue;
+    if (TMath::Abs(eta - fEta[s]) >= kEtaWindow)
+      continue;
+
+    const Float_t dphi = phi - fPhi[j];
+    Float_t dLow = Fold(dphi - qb1 * bendMin1 + fQB[j] * fBendMin[j]);
+    Float_t dHigh = 0;
+    Float_t rHigh = fMaxRadius;
+    Bool_t close = kFALSE;
+    if (curls1 || fBendMax[j] < 0)
+    {
+      // dphi* is not defined at the max radius: as before only the min radius decides, the minimum is searched up to the radius where the track curls up
+      rHigh = TMath::Max(fMinRadius, TMath::Min(fMaxRadius, TMath::Min(pt, fPt[j]) / kBend));
+      dHigh = DPhiStar(phi, pt, charge, fPhi[j], fPt[j], fCharge[j], rHigh, fBSign);
+      close = (TMath::Abs(dLow) < kLimit);
+    }
+    else
+    {
+      dHigh = Fold(dphi - qb1 * bendMax1 + fQB[j] * fBendMax[j]);
+      close = (TMath::Abs(dLow) < kLimit || TMath::Abs(dHigh) < kLimit || dLow * dHigh < 0);
+    }
+
+    if (close)
+    {
+      if (dLow * dHigh < 0)
+        fDPhiStarMin[j] = Solve(dphi, qb1, kBend / pt, fQB[j], kBend / fPt[j], fMinRadius, rHigh, dLow, dHigh);
+      else
+        fDPhiStarMin[j] = (TMath::Abs(dLow) < TMath::Abs(dHigh)) ? dLow : dHigh;
+      fMark[j] = fTag;
+      nClose++;
+    }
+  }
+
+  return nClose;
+}
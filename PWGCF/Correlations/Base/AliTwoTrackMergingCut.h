@@ -0,0 +1,72 @@
+#ifndef AliTwoTrackMergingCut_H
+#define AliTwoTrackMergingCut_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+// two-track efficiency (merging) cut on the minimal dphi* between the trigger and the associated particles
+//
+// The associated particles are sorted in eta once per event so that for a trigger particle only the pairs
+// within the deta window are visited. For a pair dphi*(r) is monotonic in r (apart from the folding at +-pi,
+// where |dphi*| is maximal), so the minimum of |dphi*| in [rmin, rmax] is either at one of the boundaries or,
+// if the sign changes, found by bisection. This replaces the scan over the radius in steps of 1 cm.
+
+#include <vector>
+#include "Rtypes.h"
+#include "TMath.h"
+
+class TObjArray;
+class TArrayF;
+
+class AliTwoTrackMergingCut
+{
+ public:
+  AliTwoTrackMergingCut(Float_t cutValue = 0.02, Float_t minRadius = 0.8, Float_t maxRadius = 2.5);
+  virtual ~AliTwoTrackMergingCut() {}
+
+  // caches the associated particles (eta taken from the array of the caller) and sorts them in eta
+  void SetAssociated(TObjArray* particles, const TArrayF& eta, Float_t bSign);
+  // determines the close pairs of this trigger particle, skip is an index not to be considered (-1 for none)
+  Int_t ProcessTrigger(Float_t eta, Float_t phi, Float_t pt, Float_t charge, Int_t skip = -1);
+
+  // pair of the last processed trigger with associated particle j passes the preselection (deta window and dphi* at the boundaries)
+  Bool_t IsClosePair(Int_t j) const { return fMark[j] == fTag; }
+  // signed dphi* with minimal absolute value (only valid if IsClosePair(j))
+  Float_t GetDPhiStarMin(Int_t j) const { return fDPhiStarMin[j]; }
+  // pair is removed by the cut
+  Bool_t IsRejected(Int_t j, Float_t deta) const { return IsClosePair(j) && TMath::Abs(fDPhiStarMin[j]) < fCutValue && TMath::Abs(deta) < fCutValue; }
+
+  Float_t GetCutValue() const { return fCutValue; }
+  Float_t GetMinRadius() const { return fMinRadius; }
+  Float_t GetMaxRadius() const { return fMaxRadius; }
+
+  // same definition as AliUEHistograms::GetDPhiStar
+  static Float_t DPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+
+ protected:
+  static Float_t Fold(Float_t dphistar);
+  static Float_t Solve(Float_t dphi, Float_t qb1, Float_t k1, Float_t qb2, Float_t k2, Float_t rLow, Float_t rHigh, Float_t dLow, Float_t dHigh);
+
+  Float_t fCutValue;           // cut on |dphi*| and |deta|
+  Float_t fMinRadius;          // min radius considered for dphi*
+  Float_t fMaxRadius;          // max radius considered for dphi*
+  Float_t fBSign;              // sign of the magnetic field
+
+  std::vector<Float_t> fEta;         // eta of associated particles, sorted
+  std::vector<Int_t> fIndex;         // index in the input array for the sorted entries
+  std::vector<Float_t> fPhi;         // phi [input index]
+  std::vector<Float_t> fPt;          // pt [input index]
+  std::vector<Float_t> fCharge;      // charge [input index]
+  std::vector<Float_t> fQB;          // charge * bSign [input index]
+  std::vector<Float_t> fBendMin;     // asin(0.075 * rmin / pt) [input index]
+  std::vector<Float_t> fBendMax;     // asin(0.075 * rmax / pt) [input index]
+  std::vector<Float_t> fDPhiStarMin; // dphi* with min |dphi*| for the last trigger [input index]
+  std::vector<UInt_t> fMark;         // equals fTag if the pair with the last trigger is close [input index]
+  UInt_t fTag;                       // counter of processed triggers
+
+ private:
+  AliTwoTrackMergingCut(const AliTwoTrackMergingCut&);
+  AliTwoTrackMergingCut& operator=(const AliTwoTrackMergingCut&);
+};
+
+#endif
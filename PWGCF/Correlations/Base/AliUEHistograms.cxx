@@ -23,6 +23,8 @@
 // Author: Jan Fiete Grosse-Oetringhaus, Sara Vallero
 
 #include "AliUEHistograms.h"
+#include "AliTwoTrackMergingCut.h"
+#include "AliUEPairAccumulator.h"
 
 #include "AliCFContainer.h"
 #include "AliBasicParticle.h"
@@ -85,6 +87,8 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   fPtOrder(kTRUE),
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
+  fUsePairAccumulator(kFALSE),
+  fPairAccumulator(0),
   fRunNumber(0),
   fMergeCount(1)
 {
@@ -266,6 +270,8 @@ AliUEHistograms::AliUEHistograms(const AliUEHistograms &c) :
   fPtOrder(kTRUE),
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
+  fUsePairAccumulator(kFALSE),
+  fPairAccumulator(0),
   fRunNumber(0),
   fMergeCount(1)
 {
@@ -423,6 +429,12 @@ void AliUEHistograms::DeleteContainers()
     delete fEfficiencyCorrectionAssociated;
     fEfficiencyCorrectionAssociated = 0;
   }
+  
+  if (fPairAccumulator)
+  {
+    delete fPairAccumulator;
+    fPairAccumulator = 0;
+  }
 }
 
 AliUEHist* AliUEHistograms::GetUEHist(Int_t id)
@@ -597,6 +609,11 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   for (Int_t i=0; i<input->GetEntriesFast(); i++)
     eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
   
+  // two-track cut: associated particles sorted in eta, close pairs are determined once per trigger particle
+  AliTwoTrackMergingCut twoTrackCut(twoTrackEfficiencyCutValue, fTwoTrackCutMinRadius);
+  if (twoTrackEfficiencyCut)
+    twoTrackCut.SetAssociated(input, eta, bSign);
+  
   // if particles is not set, just fill event statistics
   if (particles)
   {
@@ -634,6 +651,45 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
+    // pairs are summed per event in a dense buffer and added to the container at the end (see AliUEPairAccumulator)
+    // everything which depends only on one of the particles is calculated here once per particle
+    AliUEPairAccumulator* pairAccumulator = 0;
+    if (fUsePairAccumulator)
+    {
+      AliCFContainer* trackHist = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward);
+      if (!fPairAccumulator)
+        fPairAccumulator = new AliUEPairAccumulator;
+      
+      if (fPairAccumulator->GetContainer() != trackHist && !fPairAccumulator->Init(trackHist))
+      {
+        AliWarning("Pair accumulator needs an AliTHn container with 5 or 6 axes. Filling pairs directly.");
+        fUsePairAccumulator = kFALSE;
+      }
+      else
+      {
+        pairAccumulator = fPairAccumulator;
+        pairAccumulator->BeginEvent(centrality, zVtx, jMax);
+        
+        for (Int_t j=0; j<jMax; j++)
+        {
+          AliVParticle* particle = (AliVParticle*) input->UncheckedAt(j);
+          
+          Double_t assocWeight = (fillpT) ? particle->Pt() : weight;
+          if (applyEfficiency && fEfficiencyCorrectionAssociated)
+          {
+            Int_t effVars[4];
+            effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
+            effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(particle->Pt());
+            effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(centrality);
+            effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(zVtx);
+            assocWeight *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
+          }
+          
+          pairAccumulator->SetAssociated(j, eta[j], particle->Pt(), particle->Phi(), assocWeight);
+        }
+      }
+    }
+    
     // identify K, Lambda candidates and flag those particles
     // a TObject bit is used for this
     const UInt_t kResonanceDaughterFlag = 1 << 14;
@@ -738,6 +794,27 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  continue;
 	}
 	
+      if (twoTrackEfficiencyCut)
+	twoTrackCut.ProcessTrigger(triggerEta, triggerParticle->Phi(), triggerParticle->Pt(), triggerParticle->Charge(), (mixed) ? -1 : i);
+
+      if (pairAccumulator)
+      {
+	Double_t triggerWeight = 1;
+	if (applyEfficiency && fEfficiencyCorrectionTriggers)
+	{
+	  Int_t effVars[4];
+	  effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
+	  effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(triggerParticle->Pt());
+	  effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(centrality);
+	  effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(zVtx);
+	  triggerWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+	}
+	if (fWeightPerEvent)
+	  triggerWeight /= triggerWeighting->GetBinContent(triggerWeighting->GetXaxis()->FindBin(triggerParticle->Pt()));
+	
+	pairAccumulator->SetTrigger(triggerEta, triggerParticle->Pt(), triggerParticle->Phi(), triggerWeight);
+      }
+
       for (Int_t j=0; j<jMax; j++)
       {
         if (!mixed && i == j)
@@ -915,60 +992,33 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	}
 
-	if (twoTrackEfficiencyCut)
+	if (twoTrackEfficiencyCut && twoTrackCut.IsClosePair(j))
 	{
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
+	  // dphi*_min is determined in AliTwoTrackMergingCut::ProcessTrigger for pairs with |deta| < 7.5 * cut and |dphi*| < 3 * cut at the boundaries or a sign change
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
-	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
-	      
 	  Float_t deta = triggerEta - eta[j];
-	      
-	  // optimization
-	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
-	  {
-	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
-	    
-	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+	  Float_t dphistarmin = twoTrackCut.GetDPhiStarMin(j);
+	  Float_t dpt = TMath::Abs((Float_t) triggerParticle->Pt() - (Float_t) particle->Pt());
 
-	    Float_t dphistarminabs = 1e5;
-	    Float_t dphistarmin = 1e5;
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
-	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
-	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
-
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs)
-		{
-		  dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
-	      fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
-	      
-	      if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
-	      {
-// 		Printf("Removed track pair %d %d with %f %f %f %f %f %f %f %f %f", i, j, deta, dphistarminabs, phi1, pt1, charge1, phi2, pt2, charge2, bSign);
-		continue;
-	      }
+	  fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, dpt);
 
-    	      fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
-	    }
+	  if (twoTrackCut.IsRejected(j, deta))
+	  {
+// 	    Printf("Removed track pair %d %d with %f %f", i, j, deta, dphistarmin);
+	    continue;
 	  }
+
+	  fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, dpt);
 	}
         
+	if (pairAccumulator)
+	{
+	  pairAccumulator->AddPair(j);
+	  continue;
+	}
+	
         Double_t vars[6];
         vars[0] = triggerEta - eta[j];
         vars[1] = particle->Pt();
@@ -1071,6 +1121,9 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
+    if (pairAccumulator)
+      pairAccumulator->Flush(step);
+    
     if (triggerWeighting)
     {
       delete triggerWeighting;
@@ -1374,6 +1427,7 @@ void AliUEHistograms::Copy(TObject& c) const
   target.fPtOrder = fPtOrder;
   target.fTwoTrackCutMinRadius = fTwoTrackCutMinRadius;
   target.fCheckEventNumberInCorrelation = fCheckEventNumberInCorrelation;
+  target.fUsePairAccumulator = fUsePairAccumulator;
 }
 
 //____________________________________________________________________
@@ -21,6 +21,7 @@ class TObjArray;
 class TH1F;
 class TH2F;
 class TH3F;
+class AliUEPairAccumulator;
 
 class AliUEHistograms : public TNamed
 {
@@ -106,6 +107,7 @@ class AliUEHistograms : public TNamed
   void SetTwoTrackCutMinRadius(Float_t min) { fTwoTrackCutMinRadius = min; }
 
   void SetCheckEventNumberInCorrelation(Bool_t val) { fCheckEventNumberInCorrelation = val; }
+  void SetUsePairAccumulator(Bool_t flag) { fUsePairAccumulator = flag; }
   void ExtendTrackingEfficiency(Bool_t verbose = kFALSE);
   void Reset();
 
@@ -177,12 +179,14 @@ protected:
   Float_t fTwoTrackCutMinRadius; // min radius for TTR cut
 
   Bool_t fCheckEventNumberInCorrelation; // do not correlate two particles from the same event (only works for AliBasicParticles)
+  Bool_t fUsePairAccumulator;    // accumulate the pairs of FillCorrelations per event in a dense buffer (only for AliTHn containers)
+  AliUEPairAccumulator* fPairAccumulator; //! pair accumulator used if fUsePairAccumulator is set
 
   Long64_t fRunNumber;           // run number that has been processed
   
   Int_t fMergeCount;		// counts how many objects have been merged together
   
-  ClassDef(AliUEHistograms, 33)  // underlying event histogram container
+  ClassDef(AliUEHistograms, 34)  // underlying event histogram container
 };
 
 Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign)
@@ -0,0 +1,236 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// per-event accumulation of trigger-associated pairs for the AliTHn track container of AliUEHistograms
+// see header file for details
+
+#include "AliUEPairAccumulator.h"
+
+#include "TAxis.h"
+#include "AliCFContainer.h"
+#include "AliTHn.h"
+
+//____________________________________________________________________
+void AliUEPairAccumulator::Axis::Set(const TAxis* axis)
+{
+  // copies the bin edges of axis
+
+  fNbins = axis->GetNbins();
+  fEdges.resize(fNbins + 1);
+  for (Int_t i=0; i<=fNbins; i++)
+    fEdges[i] = axis->GetBinLowEdge(i+1);
+  fMin = fEdges[0];
+  fInvWidth = (fEdges[fNbins] > fMin) ? fNbins / (fEdges[fNbins] - fMin) : 0;
+}
+
+//____________________________________________________________________
+AliUEPairAccumulator::AliUEPairAccumulator() :
+  fContainer(0),
+  fNVars(0),
+  fEventOffset(-1),
+  fAssocBin(),
+  fAssocEta(),
+  fAssocPhi(),
+  fAssocWeight(),
+  fTriggerEta(0),
+  fTriggerPhi(0),
+  fTriggerWeight(0),
+  fTriggerCellOffset(-1),
+  fSlot(),
+  fSlotBin(),
+  fNCellsPerSlot(0),
+  fSumw(),
+  fSumw2(),
+  fUsed(),
+  fTouched(),
+  fUnitWeights(kTRUE),
+  fFlushBins(),
+  fFlushSumw(),
+  fFlushSumw2(),
+  fNPairs(0)
+{
+  // Constructor
+
+  for (Int_t i=0; i<6; i++)
+    fStride[i] = 0;
+}
+
+//____________________________________________________________________
+AliCFContainer* AliUEPairAccumulator::GetContainer() const
+{
+  // target container
+
+  return fContainer;
+}
+
+//____________________________________________________________________
+Bool_t AliUEPairAccumulator::Init(AliCFContainer* container)
+{
+  // takes the binning from container
+  // the bins are added directly to the storage of AliTHn, therefore other containers are not supported
+
+  fContainer = dynamic_cast<AliTHnBase*> (container);
+  if (!fContainer)
+    return kFALSE;
+
+  fNVars = fContainer->GetNVar();
+  if (fNVars < 5 || fNVars > 6)
+  {
+    fContainer = 0;
+    return kFALSE;
+  }
+
+  // global bin index as in AliTHnT::Fill (axis 0 is the slowest, no under/overflow bins)
+  for (Int_t i=0; i<fNVars; i++)
+    fAxis[i].Set(fContainer->GetAxis(i, 0));
+  Long64_t stride = 1;
+  for (Int_t i=fNVars-1; i>=0; i--)
+  {
+    fStride[i] = stride;
+    stride *= fAxis[i].GetNbins();
+  }
+
+  fNCellsPerSlot = fAxis[0].GetNbins() * fAxis[1].GetNbins() * fAxis[4].GetNbins();
+  fSlot.assign(fAxis[2].GetNbins(), -1);
+  fSlotBin.clear();
+  fSumw.clear();
+  fSumw2.clear();
+  fUsed.clear();
+  fTouched.clear();
+
+  return kTRUE;
+}
+
+//____________________________________________________________________
+Bool_t AliUEPairAccumulator::BeginEvent(Double_t centrality, Double_t zVtx, Int_t nAssociated)
+{
+  // event constant bins; the buffer is expected to be empty (Flush called for the previous event)
+
+  fEventOffset = -1;
+  fTriggerCellOffset = -1;
+  fAssocBin.assign(nAssociated, -1);
+  fAssocEta.resize(nAssociated);
+  fAssocPhi.resize(nAssociated);
+  fAssocWeight.resize(nAssociated);
+  fUnitWeights = kTRUE;
+
+  Int_t centralityBin = fAxis[3].Find(centrality);
+  if (centralityBin < 0)
+    return kFALSE;
+  Long64_t offset = centralityBin * fStride[3];
+
+  if (fNVars > 5)
+  {
+    Int_t zVtxBin = fAxis[5].Find(zVtx);
+    if (zVtxBin < 0)
+      return kFALSE;
+    offset += zVtxBin * fStride[5];
+  }
+
+  fEventOffset = offset;
+  return kTRUE;
+}
+
+//____________________________________________________________________
+void AliUEPairAccumulator::SetAssociated(Int_t j, Float_t eta, Double_t pt, Double_t phi, Double_t weight)
+{
+  // caches the associated particle j
+
+  fAssocBin[j] = (fEventOffset < 0) ? -1 : fAxis[1].Find(pt);
+  fAssocEta[j] = eta;
+  fAssocPhi[j] = phi;
+  fAssocWeight[j] = weight;
+}
+
+//____________________________________________________________________
+void AliUEPairAccumulator::SetTrigger(Float_t eta, Double_t pt, Double_t phi, Double_t weight)
+{
+  // sets the current trigger particle and assigns a buffer slot to its pT bin
+
+  fTriggerEta = eta;
+  fTriggerPhi = phi;
+  fTriggerWeight = weight;
+  fTriggerCellOffset = -1;
+
+  if (fEventOffset < 0)
+    return;
+
+  Int_t ptBin = fAxis[2].Find(pt);
+  if (ptBin < 0)
+    return;
+
+  if (fSlot[ptBin] < 0)
+  {
+    fSlot[ptBin] = fSlotBin.size();
+    fSlotBin.push_back(ptBin);
+
+    size_t size = fSlotBin.size() * fNCellsPerSlot;
+    if (fSumw.size() < size)
+    {
+      fSumw.resize(size, 0);
+      fSumw2.resize(size, 0);
+      fUsed.resize(size, 0);
+    }
+  }
+
+  fTriggerCellOffset = fSlot[ptBin] * fNCellsPerSlot;
+}
+
+//____________________________________________________________________
+void AliUEPairAccumulator::Flush(Int_t step)
+{
+  // adds the filled cells to the container and resets them
+
+  if (fTouched.size() > 0)
+  {
+    const Int_t nAssocBins = fAxis[1].GetNbins();
+    const Int_t nDPhiBins = fAxis[4].GetNbins();
+
+    Int_t n = fTouched.size();
+    fFlushBins.resize(n);
+    fFlushSumw.resize(n);
+    fFlushSumw2.resize(n);
+
+    for (Int_t i=0; i<n; i++)
+    {
+      Int_t cell = fTouched[i];
+
+      // cell = ((slot * n(deta) + deta) * n(pT,assoc) + pT,assoc) * n(dphi) + dphi
+      Int_t dphiBin = cell % nDPhiBins;
+      Int_t rest = cell / nDPhiBins;
+      Int_t assocBin = rest % nAssocBins;
+      rest /= nAssocBins;
+      Int_t detaBin = rest % fAxis[0].GetNbins();
+      Int_t slot = rest / fAxis[0].GetNbins();
+
+      fFlushBins[i] = fEventOffset + detaBin * fStride[0] + assocBin * fStride[1] + fSlotBin[slot] * fStride[2] + dphiBin * fStride[4];
+      fFlushSumw[i] = fSumw[cell];
+      fFlushSumw2[i] = fSumw2[cell];
+
+      fSumw[cell] = 0;
+      fSumw2[cell] = 0;
+      fUsed[cell] = 0;
+    }
+
+    fContainer->AddBinContents(step, n, &fFlushBins[0], &fFlushSumw[0], (fUnitWeights) ? 0 : &fFlushSumw2[0]);
+    fTouched.clear();
+  }
+
+  for (UInt_t i=0; i<fSlotBin.size(); i++)
+    fSlot[fSlotBin[i]] = -1;
+  fSlotBin.clear();
+  fTriggerCellOffset = -1;
+  fUnitWeights = kTRUE;
+}
@@ -0,0 +1,161 @@
+#ifndef AliUEPairAccumulator_H
+#define AliUEPairAccumulator_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+// per-event accumulation of trigger-associated pairs for the AliTHn track container of AliUEHistograms
+//
+// Tracks are binned once per event (associated pT, trigger pT, eta, phi, weight factors incl. efficiencies),
+// the pairs are summed with integer bin arithmetic into a dense buffer over (deta, pT,assoc, dphi) per trigger pT bin
+// and the touched bins are added to the container in one go at the end of the event (AliTHnBase::AddBinContents).
+// Axes of the container: 0 deta, 1 pT,assoc, 2 pT,trig, 3 centrality, 4 dphi, 5 zVtx (optional)
+//
+// Memory: 2 x sizeof(Double_t) x n(deta) x n(pT,assoc) x n(dphi) per trigger pT bin present in the event
+
+#include <vector>
+#include "Rtypes.h"
+#include "TMath.h"
+
+class AliCFContainer;
+class AliTHnBase;
+class TAxis;
+
+class AliUEPairAccumulator
+{
+ public:
+  AliUEPairAccumulator();
+  virtual ~AliUEPairAccumulator() {}
+
+  // binning taken from container, returns kFALSE if the container cannot be used (not an AliTHn or unexpected axes)
+  Bool_t Init(AliCFContainer* container);
+  Bool_t IsValid() const { return fContainer != 0; }
+  AliCFContainer* GetContainer() const;
+
+  // starts a new event (n associated particles), returns kFALSE if centrality or zVtx are outside the axes
+  Bool_t BeginEvent(Double_t centrality, Double_t zVtx, Int_t nAssociated);
+  // per associated particle j: kinematics and weight factor (everything that depends only on this particle)
+  void SetAssociated(Int_t j, Float_t eta, Double_t pt, Double_t phi, Double_t weight);
+  // per trigger particle: kinematics and weight factor, has to be called before the pairs of this trigger are added
+  void SetTrigger(Float_t eta, Double_t pt, Double_t phi, Double_t weight);
+  // adds the pair of the current trigger with associated particle j
+  inline void AddPair(Int_t j);
+  // adds the accumulated pairs to the container and resets the buffer
+  void Flush(Int_t step);
+
+  Long64_t GetNPairs() const { return fNPairs; }
+
+ protected:
+  // bin lookup identical to TAxis::FindBin, but returning a bin index from 0 and -1 for under/overflow
+  class Axis
+  {
+   public:
+    Axis() : fEdges(), fMin(0), fInvWidth(0), fNbins(0) {}
+    void Set(const TAxis* axis);
+    inline Int_t Find(Double_t x) const;
+    Int_t GetNbins() const { return fNbins; }
+   private:
+    std::vector<Double_t> fEdges;   // bin edges (fNbins+1)
+    Double_t fMin;                  // lower edge
+    Double_t fInvWidth;             // 1 / average bin width (start value for the search)
+    Int_t fNbins;                   // number of bins
+  };
+
+  inline void AddToBuffer(Int_t cell, Double_t weight);
+
+  AliTHnBase* fContainer;          // target container (not owned)
+  Int_t fNVars;                    // number of axes of the container
+  Axis fAxis[6];                   // axes of the container
+  Long64_t fStride[6];             // stride of each axis in the global bin index of the container
+
+  Long64_t fEventOffset;           // global bin offset from centrality and zVtx of the current event (-1: event outside)
+  std::vector<Int_t> fAssocBin;    // per associated particle: bin in pT,assoc (-1 outside)
+  std::vector<Float_t> fAssocEta;  // per associated particle: eta (deta is calculated in float as in FillCorrelations)
+  std::vector<Double_t> fAssocPhi; // per associated particle: phi
+  std::vector<Double_t> fAssocWeight; // per associated particle: weight factor
+
+  Float_t fTriggerEta;             // current trigger: eta
+  Double_t fTriggerPhi;            // current trigger: phi
+  Double_t fTriggerWeight;         // current trigger: weight factor
+  Int_t fTriggerCellOffset;        // current trigger: first cell of its pT bin in the buffer (-1 outside)
+
+  std::vector<Int_t> fSlot;        // per trigger pT bin: slot in the buffer (-1 not used in this event)
+  std::vector<Int_t> fSlotBin;     // per slot: trigger pT bin
+  Int_t fNCellsPerSlot;            // n(deta) x n(pT,assoc) x n(dphi)
+  std::vector<Double_t> fSumw;     // buffer: sum of weights per cell
+  std::vector<Double_t> fSumw2;    // buffer: sum of squared weights per cell
+  std::vector<UChar_t> fUsed;      // buffer: cell filled in this event
+  std::vector<Int_t> fTouched;     // cells filled in this event
+  Bool_t fUnitWeights;             // all pairs of this event had weight 1
+
+  std::vector<Long64_t> fFlushBins;   // flush: global bins
+  std::vector<Double_t> fFlushSumw;   // flush: sum of weights
+  std::vector<Double_t> fFlushSumw2;  // flush: sum of squared weights
+
+  Long64_t fNPairs;                // number of pairs added in total
+
+ private:
+  AliUEPairAccumulator(const AliUEPairAccumulator&);
+  AliUEPairAccumulator& operator=(const AliUEPairAccumulator&);
+};
+
+Int_t AliUEPairAccumulator::Axis::Find(Double_t x) const
+{
+  // start from the estimate for equidistant bins, then walk to the bin with fEdges[bin] <= x < fEdges[bin+1]
+
+  if (!(x >= fEdges[0]) || x >= fEdges[fNbins])
+    return -1;
+
+  Int_t bin = (Int_t) ((x - fMin) * fInvWidth);
+  if (bin < 0)
+    bin = 0;
+  if (bin >= fNbins)
+    bin = fNbins - 1;
+  while (x < fEdges[bin])
+    bin--;
+  while (x >= fEdges[bin+1])
+    bin++;
+
+  return bin;
+}
+
+void AliUEPairAccumulator::AddPair(Int_t j)
+{
+  // same variables as in AliUEHistograms::FillCorrelations
+
+  if (fTriggerCellOffset < 0 || fAssocBin[j] < 0)
+    return;
+
+  Int_t detaBin = fAxis[0].Find(fTriggerEta - fAssocEta[j]);
+  if (detaBin < 0)
+    return;
+
+  Double_t dphi = fTriggerPhi - fAssocPhi[j];
+  if (dphi > 1.5 * TMath::Pi()) 
+    dphi -= TMath::TwoPi();
+  if (dphi < -0.5 * TMath::Pi())
+    dphi += TMath::TwoPi();
+  Int_t dphiBin = fAxis[4].Find(dphi);
+  if (dphiBin < 0)
+    return;
+
+  AddToBuffer(fTriggerCellOffset + (detaBin * fAxis[1].GetNbins() + fAssocBin[j]) * fAxis[4].GetNbins() + dphiBin, fTriggerWeight * fAssocWeight[j]);
+}
+
+void AliUEPairAccumulator::AddToBuffer(Int_t cell, Double_t weight)
+{
+  // adds one entry to the buffer, remembering the cell for the flush
+
+  if (!fUsed[cell])
+  {
+    fUsed[cell] = 1;
+    fTouched.push_back(cell);
+  }
+  fSumw[cell] += weight;
+  fSumw2[cell] += weight * weight;
+  if (weight != 1)
+    fUnitWeights = kFALSE;
+  fNPairs++;
+}
+
+#endif
@@ -57,6 +57,11 @@ AliFemtoEventReader& AliFemtoEventReader::operator=(const AliFemtoEventReader& a
 }
 
 
+void AliFemtoEventReader::ReleaseHbtEvent(AliFemtoEvent* event)
+{ // Default: the event is not reused
+  delete event;
+}
+
 AliFemtoString AliFemtoEventReader::Report()
 { // Create a simple report from the workings of the reader
 
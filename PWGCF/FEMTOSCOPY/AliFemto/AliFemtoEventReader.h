@@ -58,6 +58,11 @@ public:
   /// AliFemtoEvent.
   virtual AliFemtoEvent* ReturnHbtEvent() = 0;
 
+  /// Called by AliFemtoManager once all analyses are done with an event
+  /// returned by ReturnHbtEvent. The default deletes the event; readers
+  /// recycling their femto objects take them back here.
+  virtual void ReleaseHbtEvent(AliFemtoEvent* event);
+
   /// A user-written method to return a string describing the reader,
   /// including whatever "early" cuts are being done.
   virtual AliFemtoString Report();
@@ -34,6 +34,7 @@
 #include <cassert>
 #include <memory>
 #include <map>
+#include <typeinfo>
 
 
 #ifdef __ROOT__
@@ -122,7 +123,13 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD():
   fIsKaonAnalysis(kFALSE),
   fIsProtonAnalysis(kFALSE),
   fIsPionAnalysis(kFALSE),
-  fIsElectronAnalysis(kFALSE)
+  fIsElectronAnalysis(kFALSE),
+  fRecycleEvents(kFALSE),
+  fTrackPool(),
+  fV0Pool(),
+  fXiPool(),
+  fHiddenInfoPool(),
+  fGlobalHiddenInfoPool()
 {
   // default constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -206,8 +213,13 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD(const AliFemtoEventReaderAOD &aRe
   fIsDeuteronAnalysis(aReader.fIsDeuteronAnalysis),
   fIsTritonAnalysis(aReader.fIsTritonAnalysis),
   fIsHe3Analysis(aReader.fIsHe3Analysis),
-  fIsAlphaAnalysis(aReader.fIsAlphaAnalysis)
-
+  fIsAlphaAnalysis(aReader.fIsAlphaAnalysis),
+  fRecycleEvents(aReader.fRecycleEvents),
+  fTrackPool(),
+  fV0Pool(),
+  fXiPool(),
+  fHiddenInfoPool(),
+  fGlobalHiddenInfoPool()
 {
   // copy constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -268,6 +280,7 @@ AliFemtoEventReaderAOD &AliFemtoEventReaderAOD::operator=(const AliFemtoEventRea
   fpA2013 = aReader.fpA2013;
   fisPileUp = aReader.fisPileUp;
   fCascadePileUpRemoval = aReader.fCascadePileUpRemoval;
+  fRecycleEvents = aReader.fRecycleEvents;
   fV0PileUpRemoval = aReader.fV0PileUpRemoval;
   fTrackPileUpRemoval = aReader.fTrackPileUpRemoval;
   fMVPlp = aReader.fMVPlp;
@@ -381,6 +394,122 @@ AliFemtoEvent *AliFemtoEventReaderAOD::ReturnHbtEvent()
   return hbtEvent;
 }
 
+void AliFemtoEventReaderAOD::ReleaseHbtEvent(AliFemtoEvent *event)
+{
+  /// Moves the tracks, V0s and cascades of a processed event into the pools
+  if (!fRecycleEvents || !event) {
+    delete event;
+    return;
+  }
+
+  AliFemtoTrackCollection &tracks = *event->TrackCollection();
+  for (auto *track : tracks) {
+    RecycleTrack(track);
+  }
+  fTrackPool.Trim(tracks.size());
+  fGlobalHiddenInfoPool.Trim(fReadMC ? tracks.size() : 0);
+  tracks.clear();
+
+  AliFemtoV0Collection &v0s = *event->V0Collection();
+  AliFemtoXiCollection &xis = *event->XiCollection();
+  for (auto *v0 : v0s) {
+    RecycleV0(v0);
+  }
+  for (auto *xi : xis) {
+    RecycleXi(xi);
+  }
+  fV0Pool.Trim(v0s.size() + xis.size());
+  fXiPool.Trim(xis.size());
+  fHiddenInfoPool.Trim(fReadMC ? v0s.size() + xis.size() : 0);
+  v0s.clear();
+  xis.clear();
+
+  delete event;
+}
+
+void AliFemtoEventReaderAOD::SetRecycleEvents(Bool_t recycle)
+{
+  fRecycleEvents = recycle;
+  if (!fRecycleEvents) {
+    fTrackPool.Clear();
+    fV0Pool.Clear();
+    fXiPool.Clear();
+    fHiddenInfoPool.Clear();
+    fGlobalHiddenInfoPool.Clear();
+  }
+}
+
+AliFemtoTrack *AliFemtoEventReaderAOD::NewFemtoTrack()
+{
+  return fRecycleEvents ? fTrackPool.Get() : new AliFemtoTrack();
+}
+
+AliFemtoV0 *AliFemtoEventReaderAOD::NewFemtoV0()
+{
+  return fRecycleEvents ? fV0Pool.Get() : new AliFemtoV0();
+}
+
+AliFemtoXi *AliFemtoEventReaderAOD::NewFemtoXi(const AliFemtoV0 *aV0)
+{
+  return fRecycleEvents ? fXiPool.Get(aV0) : new AliFemtoXi(aV0);
+}
+
+AliFemtoModelHiddenInfo *AliFemtoEventReaderAOD::NewModelHiddenInfo()
+{
+  return fRecycleEvents ? fHiddenInfoPool.Get() : new AliFemtoModelHiddenInfo();
+}
+
+AliFemtoModelGlobalHiddenInfo *AliFemtoEventReaderAOD::NewModelGlobalHiddenInfo()
+{
+  return fRecycleEvents ? fGlobalHiddenInfoPool.Get() : new AliFemtoModelGlobalHiddenInfo();
+}
+
+void AliFemtoEventReaderAOD::RecycleTrack(AliFemtoTrack *track)
+{
+  if (!fRecycleEvents || !track) {
+    delete track;
+    return;
+  }
+  // the hidden info is pooled on its own, detach it before the track is reset
+  RecycleHiddenInfo(track->GetHiddenInfo());
+  track->SetHiddenInfo(nullptr);
+  fTrackPool.Put(track);
+}
+
+void AliFemtoEventReaderAOD::RecycleV0(AliFemtoV0 *v0)
+{
+  if (!fRecycleEvents || !v0) {
+    delete v0;
+    return;
+  }
+  RecycleHiddenInfo(v0->GetHiddenInfo());
+  v0->SetHiddenInfo(nullptr);
+  fV0Pool.Put(v0);
+}
+
+void AliFemtoEventReaderAOD::RecycleXi(AliFemtoXi *xi)
+{
+  if (!fRecycleEvents || !xi) {
+    delete xi;
+    return;
+  }
+  RecycleHiddenInfo(xi->GetHiddenInfo());
+  xi->SetHiddenInfo(nullptr);
+  fXiPool.Put(xi);
+}
+
+void AliFemtoEventReaderAOD::RecycleHiddenInfo(AliFemtoHiddenInfo *info)
+{
+  // only the exact types created by this reader can be reset and reused
+  if (info && typeid(*info) == typeid(AliFemtoModelGlobalHiddenInfo)) {
+    fGlobalHiddenInfoPool.Put(static_cast<AliFemtoModelGlobalHiddenInfo *>(info));
+  } else if (info && typeid(*info) == typeid(AliFemtoModelHiddenInfo)) {
+    fHiddenInfoPool.Put(static_cast<AliFemtoModelHiddenInfo *>(info));
+  } else {
+    delete info;
+  }
+}
+
 AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
 {
 
@@ -558,6 +687,11 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
     }
   }
 
+  // rejected femto objects go back to the pools when recycling events
+  auto recycleTrack = [this](AliFemtoTrack *track) { RecycleTrack(track); };
+  auto recycleV0 = [this](AliFemtoV0 *v0) { RecycleV0(v0); };
+  auto recycleXi = [this](AliFemtoXi *xi) { RecycleXi(xi); };
+
   int tNormMult = 0;
   Int_t norm_mult = 0;
   for (int i = 0; i < nofTracks; i++) {
@@ -651,7 +785,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
 
     tEvent->SetNormalizedMult(norm_mult);
 
-    std::unique_ptr<AliFemtoTrack> trackCopy(CopyAODtoFemtoTrack(aodtrack));
+    std::unique_ptr<AliFemtoTrack, decltype(recycleTrack)> trackCopy(CopyAODtoFemtoTrack(aodtrack), recycleTrack);
 
     trackCopy->SetMultiplicity(norm_mult);
     trackCopy->SetZvtx(fV1[2]);
@@ -705,7 +839,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
                                     : !fReadFullMCData ? nullptr
                                     : static_cast<const AliAODMCParticle *>(mcP->At(std::abs(track_label)));
 
-      AliFemtoModelGlobalHiddenInfo *tInfo = new AliFemtoModelGlobalHiddenInfo();
+      AliFemtoModelGlobalHiddenInfo *tInfo = NewModelGlobalHiddenInfo();
       double fpx = 0.0, fpy = 0.0, fpz = 0.0, fpt = 0.0;
       if (!tPart) {
         fpx = fV1[0];
@@ -962,7 +1096,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
         }
       }
 
-      std::unique_ptr<AliFemtoV0> trackCopyV0(CopyAODtoFemtoV0(aodv0));
+      std::unique_ptr<AliFemtoV0, decltype(recycleV0)> trackCopyV0(CopyAODtoFemtoV0(aodv0), recycleV0);
       trackCopyV0->SetMultiplicity(norm_mult);
       trackCopyV0->SetZvtx(fV1[2]);
 
@@ -984,7 +1118,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
             // If both daughter tracks refer to the same mother, we can continue
             if ((motherOfPosID > -1) && (motherOfPosID == motherOfNegID)) {
               // Create the MC data store
-              AliFemtoModelHiddenInfo *tInfo = new AliFemtoModelHiddenInfo();
+              AliFemtoModelHiddenInfo *tInfo = NewModelHiddenInfo();
 
               // Our V0 particle
               const AliAODMCParticle *v0 = static_cast<AliAODMCParticle *>(mcP->At(motherOfPosID));
@@ -1100,7 +1234,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
         }
       }
 
-      std::unique_ptr<AliFemtoXi> trackCopyXi(CopyAODtoFemtoXi(aodxi));
+      std::unique_ptr<AliFemtoXi, decltype(recycleXi)> trackCopyXi(CopyAODtoFemtoXi(aodxi), recycleXi);
 
       //TODO for now, in AliFemtoHiddenInfo, consider V0 as positive daughter and bachelor pion as negative daughter
       //Methods will either be added to AliFemtoHiddenInfo to handle the Cascade case, or a new class will be constructed
@@ -1137,7 +1271,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
               // If both V0 and bachelor pion trakcs refer to the same mother, we can continue
               if ((motherOfV0ID > -1) && (motherOfV0ID == motherOfBacID)) {
                 // Create the MC data store
-                AliFemtoModelHiddenInfo *tInfo = new AliFemtoModelHiddenInfo();
+                AliFemtoModelHiddenInfo *tInfo = NewModelHiddenInfo();
                 const AliAODMCParticle *xi = static_cast<AliAODMCParticle *>(mcP->At(motherOfV0ID));
 
                 if (xi == nullptr) {
@@ -1198,7 +1332,7 @@ AliFemtoTrack *AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(const AliAODTrack *tA
 {
   // Copy the track information from the AOD into the internal AliFemtoTrack
   // If it exists, use the additional information from the PWG2 AOD
-  AliFemtoTrack *tFemtoTrack = new AliFemtoTrack();
+  AliFemtoTrack *tFemtoTrack = NewFemtoTrack();
 
   // Primary Vertex position
   fEvent->GetPrimaryVertex()->GetPosition(fV1);
@@ -1459,7 +1593,7 @@ AliFemtoTrack *AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(const AliAODTrack *tA
 
 AliFemtoV0 *AliFemtoEventReaderAOD::CopyAODtoFemtoV0(AliAODv0 *tAODv0)
 {
-  AliFemtoV0 *tFemtoV0 = new AliFemtoV0();
+  AliFemtoV0 *tFemtoV0 = NewFemtoV0();
 
   tFemtoV0->SetdecayLengthV0(tAODv0->DecayLength(fV1));
   tFemtoV0->SetdecayVertexV0X(tAODv0->DecayVertexV0X());
@@ -1800,8 +1934,8 @@ AliFemtoXi *AliFemtoEventReaderAOD::CopyAODtoFemtoXi(AliAODcascade *tAODxi)
 
   { // this is to keep tmpV0 in its own scope
     AliFemtoV0 *tmpV0 = CopyAODtoFemtoV0(tAODxi);
-    tFemtoXi = new AliFemtoXi(tmpV0);
-    delete tmpV0;
+    tFemtoXi = NewFemtoXi(tmpV0);
+    RecycleV0(tmpV0);
   }
 
   //The above lines set the V0 attributes.  However, some of these are now set incorrectly
@@ -11,6 +11,7 @@
 #define ALIFEMTOEVENTREADERAOD_H
 #include "AliFemtoEventReader.h"
 #include "AliFemtoEnumeration.h"
+#include "AliFemtoObjectPool.h"
 
 #include <string>
 
@@ -24,13 +25,15 @@
 #include "AliAODMCParticle.h"
 #include "AliFemtoV0.h"
 #include "AliFemtoXi.h"
+#include "AliFemtoTrack.h"
+#include "AliFemtoModelHiddenInfo.h"
+#include "AliFemtoModelGlobalHiddenInfo.h"
 #include "AliAODpidUtil.h"
 #include "AliAODHeader.h"
 #include "AliAnalysisUtils.h"
 #include "AliEventCuts.h"
 
 class AliFemtoEvent;
-class AliFemtoTrack;
 
 class AliFemtoEventReaderAOD : public AliFemtoEventReader {
 public:
@@ -50,6 +53,7 @@ public:
   AliFemtoEventReaderAOD &operator=(const AliFemtoEventReaderAOD &aReader);
 
   virtual AliFemtoEvent *ReturnHbtEvent();
+  virtual void ReleaseHbtEvent(AliFemtoEvent *event);
   AliFemtoString Report();
   void SetInputFile(const char *inputfile);
 
@@ -128,6 +132,14 @@ public:
   void SetShiftedPositions(const AliAODTrack *track ,const Float_t bfield, Float_t posShifted[3], const Double_t radius=1.25);
 
   void SetUseAliEventCuts(Bool_t useAliEventCuts);
+
+  /// Reuse the tracks, V0s and cascades (with their hidden info) of the
+  /// events handed back through ReleaseHbtEvent instead of allocating
+  /// new ones for every event
+  void SetRecycleEvents(Bool_t recycle);
+  bool GetRecycleEvents() const {
+    return fRecycleEvents;
+  }
   void SetReadFullMCData(Bool_t should_read=true);
   bool GetReadFullMCData() const;
 
@@ -181,6 +193,20 @@ protected:
   virtual AliFemtoXi *CopyAODtoFemtoXi(AliAODcascade *tAODxi);
   virtual void CopyPIDtoFemtoTrack(const AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack);
 
+  /// Allocation of the femto objects, served from the pools when
+  /// recycling events
+  AliFemtoTrack *NewFemtoTrack();
+  AliFemtoV0 *NewFemtoV0();
+  AliFemtoXi *NewFemtoXi(const AliFemtoV0 *aV0);
+  AliFemtoModelHiddenInfo *NewModelHiddenInfo();
+  AliFemtoModelGlobalHiddenInfo *NewModelGlobalHiddenInfo();
+
+  /// Disposal of femto objects which did not make it into an event
+  void RecycleTrack(AliFemtoTrack *track);
+  void RecycleV0(AliFemtoV0 *v0);
+  void RecycleXi(AliFemtoXi *xi);
+  void RecycleHiddenInfo(AliFemtoHiddenInfo *info);
+
   int            fNumberofEvent;    ///< number of Events in AOD file
   int            fCurEvent;         ///< number of current event
   AliAODEvent   *fEvent;            ///< AOD event
@@ -275,10 +301,17 @@ private:
   Bool_t fIsAlphaAnalysis;
   //
 
+  Bool_t fRecycleEvents;  ///< reuse the femto objects of released events
+  AliFemtoObjectPool<AliFemtoTrack> fTrackPool;  //!<! recycled tracks
+  AliFemtoObjectPool<AliFemtoV0> fV0Pool;        //!<! recycled V0s
+  AliFemtoObjectPool<AliFemtoXi> fXiPool;        //!<! recycled cascades
+  AliFemtoObjectPool<AliFemtoModelHiddenInfo> fHiddenInfoPool;             //!<! recycled V0 and cascade hidden info
+  AliFemtoObjectPool<AliFemtoModelGlobalHiddenInfo> fGlobalHiddenInfoPool; //!<! recycled track hidden info
+
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoEventReaderAOD, 13);
+  ClassDef(AliFemtoEventReaderAOD, 14);
   /// \endcond
 #endif
 
@@ -12,6 +12,12 @@
 //#include "AliFemtoTrackCut.h"
 //#include "AliFemtoV0Cut.h"
 #include <cstdio>
+#include <vector>
+
+#include <TROOT.h>
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -25,7 +31,9 @@
 AliFemtoManager::AliFemtoManager():
   fAnalysisCollection(nullptr),
   fEventReader(nullptr),
-  fEventWriterCollection(nullptr)
+  fEventWriterCollection(nullptr),
+  fNThreads(0),
+  fThreadPool(nullptr)
 {
   // default constructor
   fAnalysisCollection = new AliFemtoAnalysisCollection;
@@ -35,9 +43,12 @@ AliFemtoManager::AliFemtoManager():
 AliFemtoManager::AliFemtoManager(const AliFemtoManager& aManager):
   fAnalysisCollection(new AliFemtoAnalysisCollection),
   fEventReader(aManager.fEventReader),
-  fEventWriterCollection(new AliFemtoEventWriterCollection)
+  fEventWriterCollection(new AliFemtoEventWriterCollection),
+  fNThreads(0),
+  fThreadPool(nullptr)
 {
   // copy constructor
+  SetNThreads(aManager.fNThreads);
   for (auto *analysis : *aManager.fAnalysisCollection) {
     fAnalysisCollection->push_back(analysis);
   }
@@ -61,6 +72,9 @@ AliFemtoManager::~AliFemtoManager()
     delete writer;
   }
   delete fEventWriterCollection;
+#ifdef R__USE_IMT
+  delete fThreadPool;
+#endif
 }
 //____________________________
 AliFemtoManager& AliFemtoManager::operator=(const AliFemtoManager& aManager)
@@ -71,6 +85,7 @@ AliFemtoManager& AliFemtoManager::operator=(const AliFemtoManager& aManager)
   }
 
   fEventReader = aManager.fEventReader;
+  SetNThreads(aManager.fNThreads);
 
 
   for (auto *analysis : *fAnalysisCollection) {
@@ -93,10 +108,27 @@ AliFemtoManager& AliFemtoManager::operator=(const AliFemtoManager& aManager)
   return *this;
 }
 
+//____________________________
+void AliFemtoManager::SetNThreads(int n)
+{
+  // (re)create the pool running the analyses
+  fNThreads = n;
+#ifdef R__USE_IMT
+  delete fThreadPool;
+  fThreadPool = (fNThreads > 1) ? new ROOT::TThreadExecutor(fNThreads) : nullptr;
+#endif
+}
+
 //____________________________
 int AliFemtoManager::Init()
 {
   // Execute initialization procedures
+#ifdef R__USE_IMT
+  // the pool is transient - recreate it after the manager was read back
+  if (!fThreadPool && fNThreads > 1) {
+    SetNThreads(fNThreads);
+  }
+#endif
   AliFemtoString readerMessage;
   readerMessage += "*** *** *** *** *** *** *** *** *** *** *** *** \n";
   // EventReader
@@ -193,7 +225,7 @@ int AliFemtoManager::ProcessEvent()
   // process a single event by reading it and passing it to each
   // analysis and event writer
   //  cout << "AliFemtoManager::ProcessEvent" << endl;
-  // NOTE - this ReturnHbtEvent makes a *new* AliFemtoEvent - delete it when done!
+  // NOTE - the event returned by ReturnHbtEvent is handed back to the reader when done!
   AliFemtoEvent* currentHbtEvent = fEventReader->ReturnHbtEvent();
   //  cout << "Event reader has returned control to manager" << endl;
   // if no HbtEvent is returned, then we abort processing.
@@ -210,14 +242,18 @@ int AliFemtoManager::ProcessEvent()
   }
 
   // loop over all the Analysis
+#ifdef R__USE_IMT
+  if (fThreadPool && fAnalysisCollection->size() > 1) {
+    const AliFemtoEvent *event = currentHbtEvent;
+    std::vector<AliFemtoAnalysis*> analyses(fAnalysisCollection->begin(), fAnalysisCollection->end());
+    fThreadPool->Foreach([event](AliFemtoAnalysis *analysis) { analysis->ProcessEvent(event); }, analyses);
+  } else
+#endif
   for (auto *analysis : *fAnalysisCollection) {
     analysis->ProcessEvent(currentHbtEvent);
   }
 
-  if (currentHbtEvent) {
-    delete currentHbtEvent;
-    currentHbtEvent = NULL;
-  }
+  fEventReader->ReleaseHbtEvent(currentHbtEvent);
 
   return 0;    // 0 = "good return"
 }       // ProcessEvent
@@ -19,6 +19,7 @@
 #include "AliFemtoEventReader.h"
 #include "AliFemtoEventWriter.h"
 
+namespace ROOT { class TThreadExecutor; }
 
 /// \class AliFemtoManager
 /// \brief Main class for managing femtoscopic analyses
@@ -49,6 +50,8 @@ private:
   AliFemtoAnalysisCollection* fAnalysisCollection;       ///< Collection of analyzes
   AliFemtoEventReader*        fEventReader;              ///< Event reader
   AliFemtoEventWriterCollection* fEventWriterCollection; ///< Event writer collection
+  int fNThreads;                                         ///< Number of threads running the analyses (0 or 1: serial)
+  ROOT::TThreadExecutor* fThreadPool;                    //!<! Pool running the analyses, created once per manager
 
   AliFemtoManager(const AliFemtoManager& aManager);
   AliFemtoManager& operator=(const AliFemtoManager& aManager);
@@ -70,6 +73,16 @@ public:
   AliFemtoEventReader* EventReader();
   void SetEventReader(AliFemtoEventReader* r);
 
+  /// Run the analyses of each event on a pool of n threads
+  ///
+  /// Only available with ROOT implicit multithreading. The analyses
+  /// receive the same (read-only) event and must not share cuts,
+  /// correlation functions, or other mutable objects. Analyses drawing
+  /// from gRandom are no longer reproducible in this mode.
+  ///
+  void SetNThreads(int n);
+  int GetNThreads() const { return fNThreads; }
+
   /// Calls `Init()` on all owned EventWriters
   ///
   /// Returns 0 for success, 1 for failure.
@@ -0,0 +1,92 @@
+///
+/// \file AliFemtoObjectPool.h
+///
+
+#ifndef ALIFEMTOOBJECTPOOL_H
+#define ALIFEMTOOBJECTPOOL_H
+
+#include <vector>
+#include <cstddef>
+
+/// \class AliFemtoObjectPool
+/// \brief Free list of heap allocated femto objects reused between events
+///
+/// Objects handed out by Get() are ordinary heap objects: whoever ends up
+/// owning one may simply delete it, the pool only loses the chance to reuse
+/// it. Recycled objects are reset by assignment from a freshly constructed
+/// object, so the assignment operator of the class must set every member
+/// the copy constructor sets. A member it skips keeps its value from the
+/// previous event.
+///
+/// The number of kept objects follows the recent multiplicities passed to
+/// Trim(): it jumps up to the multiplicity of a large event and decays
+/// slowly afterwards, so a single central event does not pin its memory for
+/// the rest of the job.
+///
+template <typename T>
+class AliFemtoObjectPool {
+public:
+  AliFemtoObjectPool():
+    fFree(),
+    fCapacity(0)
+  {
+  }
+
+  ~AliFemtoObjectPool()
+  {
+    Clear();
+  }
+
+  /// Return an object equal to T(args...), reusing a pooled one if possible
+  template <typename... Args>
+  T* Get(const Args&... args)
+  {
+    if (fFree.empty()) {
+      return new T(args...);
+    }
+    T *obj = fFree.back();
+    fFree.pop_back();
+    *obj = T(args...);
+    return obj;
+  }
+
+  /// Give an object back to the pool
+  void Put(T *obj)
+  {
+    if (obj) {
+      fFree.push_back(obj);
+    }
+  }
+
+  /// Adapt the pool to the number of objects used in the last event and
+  /// delete the objects exceeding it
+  void Trim(std::size_t used)
+  {
+    fCapacity = (used > fCapacity) ? used : fCapacity - fCapacity / 16;
+    while (fFree.size() > fCapacity) {
+      delete fFree.back();
+      fFree.pop_back();
+    }
+  }
+
+  /// Delete all pooled objects
+  void Clear()
+  {
+    for (auto *obj : fFree) {
+      delete obj;
+    }
+    fFree.clear();
+    fCapacity = 0;
+  }
+
+  std::size_t Size() const { return fFree.size(); }
+
+private:
+  AliFemtoObjectPool(const AliFemtoObjectPool&);
+  AliFemtoObjectPool& operator=(const AliFemtoObjectPool&);
+
+  std::vector<T*> fFree;   ///< objects ready for reuse
+  std::size_t fCapacity;   ///< maximum number of kept objects
+};
+
+#endif
@@ -53,6 +53,7 @@ AliFemtoPair::AliFemtoPair():
   // Default constructor
   SetDefaultHalfFieldMergingPar();
   std::fill_n(fAverageSeparations, 4, NAN);
+  std::fill_n(fKinematicsCache, (int)kNKinematicsCache, NAN);
   std::fill_n(fFemtoWeightCache, 3, std::make_pair(0, NAN));
 }
 
@@ -93,6 +94,7 @@ AliFemtoPair::AliFemtoPair(AliFemtoParticle* a, AliFemtoParticle* b):
   // Construct a pair from two particles
   SetDefaultHalfFieldMergingPar();
   std::fill_n(fAverageSeparations, 4, NAN);
+  std::fill_n(fKinematicsCache, (int)kNKinematicsCache, NAN);
   std::fill_n(fFemtoWeightCache, 3, std::make_pair(0, NAN));
 }
 
@@ -164,6 +166,7 @@ AliFemtoPair::AliFemtoPair(const AliFemtoPair &aPair):
   // Copy constructor
   /* no-op */
   std::fill_n(fAverageSeparations, 4, NAN);
+  std::fill_n(fKinematicsCache, (int)kNKinematicsCache, NAN);
 }
 
 AliFemtoPair& AliFemtoPair::operator=(const AliFemtoPair &aPair)
@@ -216,6 +219,7 @@ AliFemtoPair& AliFemtoPair::operator=(const AliFemtoPair &aPair)
   fClosestRowAtDCAV0NegV0Neg = aPair.fClosestRowAtDCAV0NegV0Neg;
 
   std::fill_n(fAverageSeparations, 4, NAN);
+  std::fill_n(fKinematicsCache, (int)kNKinematicsCache, NAN);
 
   return *this;
 }
@@ -229,15 +233,21 @@ double AliFemtoPair::GetPairAngleEP() const
 double AliFemtoPair::MInv() const
 {
   // invariant mass
-    double tInvariantMass = abs(fTrack1->FourMomentum() + fTrack2->FourMomentum());
-    return tInvariantMass;
+  double &tInvariantMass = fKinematicsCache[kCacheMInv];
+  if (std::isnan(tInvariantMass)) {
+    tInvariantMass = abs(fTrack1->FourMomentum() + fTrack2->FourMomentum());
+  }
+  return tInvariantMass;
 }
 //_________________
 double AliFemtoPair::KT() const
 {
   // transverse momentum
-  double tmp = (fTrack1->FourMomentum() + fTrack2->FourMomentum()).Perp();
-  tmp *= .5;
+  double &tmp = fKinematicsCache[kCacheKT];
+  if (std::isnan(tmp)) {
+    tmp = (fTrack1->FourMomentum() + fTrack2->FourMomentum()).Perp();
+    tmp *= .5;
+  }
 
   return tmp;
 }
@@ -391,6 +401,9 @@ void AliFemtoPair::QYKPPF(double& qP, double& qT, double& q0) const
 double AliFemtoPair::QOutCMS() const
 {
   // relative momentum out component in lab frame
+  if (!std::isnan(fKinematicsCache[kCacheQOutCMS])) {
+    return fKinematicsCache[kCacheQOutCMS];
+  }
   const AliFemtoThreeVector
     &p1 = fTrack1->FourMomentum().vect(),
     &p2 = fTrack2->FourMomentum().vect();
@@ -405,13 +418,16 @@ double AliFemtoPair::QOutCMS() const
     k = dx*px + dy*py,
     pt = ::sqrt(px*px + py*py);
 
-  return CHECKED_DIVIDE_ELSE_ZERO(k, pt);
+  return fKinematicsCache[kCacheQOutCMS] = CHECKED_DIVIDE_ELSE_ZERO(k, pt);
 }
 
 //_________________
 double AliFemtoPair::QSideCMS() const
 {
   // relative momentum side component in lab frame
+  if (!std::isnan(fKinematicsCache[kCacheQSideCMS])) {
+    return fKinematicsCache[kCacheQSideCMS];
+  }
   const AliFemtoThreeVector
     &p1 = fTrack1->FourMomentum().vect(),
     &p2 = fTrack2->FourMomentum().vect();
@@ -429,13 +445,16 @@ double AliFemtoPair::QSideCMS() const
     k = 2.0 * (x2*y1 - x1*y2),
     pt = ::sqrt(xt*xt + yt*yt);
 
-  return CHECKED_DIVIDE_ELSE_ZERO(k, pt);
+  return fKinematicsCache[kCacheQSideCMS] = CHECKED_DIVIDE_ELSE_ZERO(k, pt);
 }
 
 //_________________________
 double AliFemtoPair::QLongCMS() const
 {
   // relative momentum component in lab frame
+  if (!std::isnan(fKinematicsCache[kCacheQLongCMS])) {
+    return fKinematicsCache[kCacheQLongCMS];
+  }
   const AliFemtoLorentzVector
     &tmp1 = fTrack1->FourMomentum(),
     &tmp2 = fTrack2->FourMomentum();
@@ -449,7 +468,7 @@ double AliFemtoPair::QLongCMS() const
   double beta = zz/tt;
   double gamma = 1.0/TMath::Sqrt((1.-beta)*(1.+beta));
 
-  return gamma * (dz - beta*dt);
+  return fKinematicsCache[kCacheQLongCMS] = gamma * (dz - beta*dt);
 }
 
 //________________________________
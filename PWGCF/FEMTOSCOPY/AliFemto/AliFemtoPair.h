@@ -278,6 +278,11 @@ private:
   /// Cache value of ssharing
   mutable double fSharingCache[2];
 
+  /// Cache of the pair kinematics shared by the pair cuts and the
+  /// correlation functions, NAN if not calculated
+  enum { kCacheQInv, kCacheKT, kCacheMInv, kCacheQOutCMS, kCacheQSideCMS, kCacheQLongCMS, kNKinematicsCache };
+  mutable double fKinematicsCache[kNKinematicsCache];
+
   /// Cache for re-using MC-generated weights
   /// First item in pair is pointer to weight, second is the weight
   mutable std::pair<std::intptr_t, double> fFemtoWeightCache[3];
@@ -316,6 +321,7 @@ inline void AliFemtoPair::ResetParCalculated(){
 
   std::fill_n(fAverageSeparations, 4, NAN);
   std::fill_n(fSharingCache, 2, NAN);
+  std::fill_n(fKinematicsCache, (int)kNKinematicsCache, NAN);
   ClearWeightCache();
 }
 
@@ -348,8 +354,12 @@ inline double AliFemtoPair::KStar() const{
   return fKStarCalc;
 }
 inline double AliFemtoPair::QInv() const {
-  AliFemtoLorentzVector tDiff = (fTrack1->FourMomentum()-fTrack2->FourMomentum());
-  return -tDiff.m();
+  double &qinv = fKinematicsCache[kCacheQInv];
+  if (std::isnan(qinv)) {
+    AliFemtoLorentzVector tDiff = (fTrack1->FourMomentum()-fTrack2->FourMomentum());
+    qinv = -tDiff.m();
+  }
+  return qinv;
 }
 
 // Fabrice private <<<
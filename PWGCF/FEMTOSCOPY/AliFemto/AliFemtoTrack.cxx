@@ -269,6 +269,7 @@ AliFemtoTrack& AliFemtoTrack::operator=(const AliFemtoTrack& aTrack)
   fNSigmaTPCH=aTrack.fNSigmaTPCH;
   fNSigmaTPCA=aTrack.fNSigmaTPCA;
   fMassTOF=aTrack.fMassTOF;
+  fSigmaToVertex=aTrack.fSigmaToVertex;
   fNSigmaTOFPi=aTrack.fNSigmaTOFPi;
   fNSigmaTOFK=aTrack.fNSigmaTOFK;
   fNSigmaTOFP=aTrack.fNSigmaTOFP;
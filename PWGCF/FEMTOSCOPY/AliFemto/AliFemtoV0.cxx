@@ -136,6 +136,7 @@ AliFemtoV0& AliFemtoV0::operator=(const AliFemtoV0& aV0)
     return *this;
   fDecayLengthV0 = aV0.fDecayLengthV0;
   fDecayVertexV0 = aV0.fDecayVertexV0;
+  fPrimaryVertex = aV0.fPrimaryVertex;
   fDcaV0Daughters = aV0.fDcaV0Daughters;
   fDcaV0ToPrimVertex = aV0.fDcaV0ToPrimVertex;
   fDcaPosToPrimVertex = aV0.fDcaPosToPrimVertex;
@@ -242,6 +243,8 @@ AliFemtoV0& AliFemtoV0::operator=(const AliFemtoV0& aV0)
   
   if (fHiddenInfo) delete fHiddenInfo;
   fHiddenInfo = aV0.fHiddenInfo? aV0.fHiddenInfo->Clone() : NULL;// GR 11 DEC 02
+  // UpdateV0 keeps alpha if it cannot be calculated, start from 0 as the copy constructor
+  fAlphaV0 = 0;
   UpdateV0();
 
   return *this;
@@ -141,6 +141,17 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
   if (PDGPart1 == 0 || PDGPart2 == 0) {
     AliError("Invalid PDG Code");
   }
+  return FillSameEvent(iHC, Mult, cent, part1,
+                       TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass(),
+                       part2,
+                       TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
+}
+
+float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
+                                                 AliFemtoDreamBasePart &part1,
+                                                 double massPart1,
+                                                 AliFemtoDreamBasePart &part2,
+                                                 double massPart2) {
   bool fillHists = fWhichPairs.at(iHC);
   TLorentzVector PartOne, PartTwo;
   TVector3 Part1Momentum = part1.GetMomentum();
@@ -149,9 +160,9 @@ float AliFemtoDreamHigherPairMath::FillSameEvent(int iHC, int Mult, float cent,
 // here cause we are
 // only looking at the mother mass
   PartOne.SetXYZM(Part1Momentum.X(), Part1Momentum.Y(), Part1Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass());
+                  massPart1);
   PartTwo.SetXYZM(Part2Momentum.X(), Part2Momentum.Y(), Part2Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
+                  massPart2);
 
   float RelativeK = RelativePairMomentum(PartOne, PartTwo);
   fHists->FillSameEventDist(iHC, RelativeK);
@@ -213,10 +224,15 @@ void AliFemtoDreamHigherPairMath::MassQA(int iHC, float RelK,
                                          AliFemtoDreamBasePart &part1, int PDGPart1,
                                          AliFemtoDreamBasePart &part2, int PDGPart2) {
   if (fWhichPairs.at(iHC) && fHists->GetDoMassQA()) {
-    const float massPart1 = TDatabasePDG::Instance()->GetParticle(
-              PDGPart1)->Mass();
-    const float massPart2 = TDatabasePDG::Instance()->GetParticle(
-              PDGPart2)->Mass();
+    MassQA(iHC, RelK, part1,
+           TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass(), part2,
+           TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
+  }
+}
+void AliFemtoDreamHigherPairMath::MassQA(int iHC, float RelK,
+                                         AliFemtoDreamBasePart &part1, double massPart1,
+                                         AliFemtoDreamBasePart &part2, double massPart2) {
+  if (fWhichPairs.at(iHC) && fHists->GetDoMassQA()) {
     fHists->FillMassQADist(iHC, RelK, part1.GetInvMass(), part2.GetInvMass());
     fHists->FillPairInvMassQAD(iHC, part1, part2);
     fHists->FillPDGPairInvMassQAD(iHC, RelK, part1, massPart1, part2, massPart2);
@@ -226,10 +242,15 @@ void AliFemtoDreamHigherPairMath::MEMassQA(int iHC, float RelK,
                                          AliFemtoDreamBasePart &part1, int PDGPart1,
                                          AliFemtoDreamBasePart &part2, int PDGPart2) {
   if (fWhichPairs.at(iHC) && fHists->GetDoMassQA()) {
-    const float massPart1 = TDatabasePDG::Instance()->GetParticle(
-              PDGPart1)->Mass();
-    const float massPart2 = TDatabasePDG::Instance()->GetParticle(
-              PDGPart2)->Mass();
+    MEMassQA(iHC, RelK, part1,
+             TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass(), part2,
+             TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
+  }
+}
+void AliFemtoDreamHigherPairMath::MEMassQA(int iHC, float RelK,
+                                         AliFemtoDreamBasePart &part1, double massPart1,
+                                         AliFemtoDreamBasePart &part2, double massPart2) {
+  if (fWhichPairs.at(iHC) && fHists->GetDoMassQA()) {
     fHists->FillMEMassQADist(iHC, RelK, part1.GetInvMass(), part2.GetInvMass());
     fHists->FillPairInvMEMassQAD(iHC, part1, part2);
     fHists->FillPDGPairInvMEMassQAD(iHC, RelK, part1, massPart1, part2, massPart2);
@@ -243,6 +264,17 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
   if (PDGPart1 == 0 || PDGPart2 == 0) {
     AliError("Invalid PDG Code");
   }
+  return FillMixedEvent(iHC, Mult, cent, part1,
+                        TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass(),
+                        part2,
+                        TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass(),
+                        mode);
+}
+
+float AliFemtoDreamHigherPairMath::FillMixedEvent(
+    int iHC, int Mult, float cent, AliFemtoDreamBasePart &part1,
+    double massPart1, AliFemtoDreamBasePart &part2, double massPart2,
+    AliFemtoDreamCollConfig::UncorrelatedMode mode) {
   bool fillHists = fWhichPairs.at(iHC);
   TLorentzVector PartOne, PartTwo;
   TVector3 Part1Momentum = part1.GetMomentum();
@@ -251,9 +283,9 @@ float AliFemtoDreamHigherPairMath::FillMixedEvent(
 // here cause we are
 // only looking at the mother mass
   PartOne.SetXYZM(Part1Momentum.X(), Part1Momentum.Y(), Part1Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass());
+                  massPart1);
   PartTwo.SetXYZM(Part2Momentum.X(), Part2Momentum.Y(), Part2Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
+                  massPart2);
 // Do the randomization here
   if (mode == AliFemtoDreamCollConfig::kStravinsky) {
     if (fRandom.Uniform() < 0.5) {
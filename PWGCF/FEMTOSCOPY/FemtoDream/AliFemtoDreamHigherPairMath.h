@@ -38,10 +38,19 @@ class AliFemtoDreamHigherPairMath {
   void RecalculatePhiStar(AliFemtoDreamBasePart &part);
   float FillSameEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
                       int PDGPart1, AliFemtoDreamBasePart& part2, int PDGPart2);
+  // Same with the masses of the species already resolved by the caller
+  float FillSameEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
+                      double massPart1, AliFemtoDreamBasePart& part2,
+                      double massPart2);
   void MassQA(int iHC, float RelK, AliFemtoDreamBasePart &part1, int PDGPart1,
               AliFemtoDreamBasePart &part2, int PDGPart2);
+  void MassQA(int iHC, float RelK, AliFemtoDreamBasePart &part1,
+              double massPart1, AliFemtoDreamBasePart &part2, double massPart2);
   void MEMassQA(int iHC, float RelK, AliFemtoDreamBasePart &part1, int PDGPart1,
               AliFemtoDreamBasePart &part2, int PDGPart2);
+  void MEMassQA(int iHC, float RelK, AliFemtoDreamBasePart &part1,
+                double massPart1, AliFemtoDreamBasePart &part2,
+                double massPart2);
   void SEMomentumResolution(int iHC, AliFemtoDreamBasePart* part1, int PDGPart1,
                             AliFemtoDreamBasePart* part2, int PDGPart2,
                             float RelativeK);
@@ -55,6 +64,10 @@ class AliFemtoDreamHigherPairMath {
   float FillMixedEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
                        int PDGPart1, AliFemtoDreamBasePart& part2, int PDGPart2,
                        AliFemtoDreamCollConfig::UncorrelatedMode mode);
+  float FillMixedEvent(int iHC, int Mult, float cent, AliFemtoDreamBasePart& part1,
+                       double massPart1, AliFemtoDreamBasePart& part2,
+                       double massPart2,
+                       AliFemtoDreamCollConfig::UncorrelatedMode mode);
   void MEMomentumResolution(int iHC, AliFemtoDreamBasePart* part1, int PDGPart1,
                             AliFemtoDreamBasePart* part2, int PDGPart2,
                             float RelativeK);
@@ -5,6 +5,7 @@
  *      Author: bernhardhohlweger
  */
 
+#include <algorithm>
 #include <iostream>
 #include "AliFemtoDreamPairCleaner.h"
 ClassImp(AliFemtoDreamPairCleaner)
@@ -12,7 +13,11 @@ AliFemtoDreamPairCleaner::AliFemtoDreamPairCleaner()
     : fMinimalBooking(false),
       fCounter(0),
       fParticles(),
-      fHists(0) {
+      fHists(0),
+      fIDHead(),
+      fIDEntries(),
+      fIDs(),
+      fCandidates() {
 }
 
 AliFemtoDreamPairCleaner::AliFemtoDreamPairCleaner(
@@ -20,7 +25,11 @@ AliFemtoDreamPairCleaner::AliFemtoDreamPairCleaner(
     : fMinimalBooking(cleaner.fMinimalBooking),
       fCounter(0),
       fParticles(),
-      fHists(cleaner.fHists) {
+      fHists(cleaner.fHists),
+      fIDHead(),
+      fIDEntries(),
+      fIDs(),
+      fCandidates() {
 }
 
 AliFemtoDreamPairCleaner::AliFemtoDreamPairCleaner(int nTrackDecayChecks,
@@ -29,7 +38,11 @@ AliFemtoDreamPairCleaner::AliFemtoDreamPairCleaner(int nTrackDecayChecks,
     : fMinimalBooking(MinimalBooking),
       fCounter(0),
       fParticles(),
-      fHists(nullptr) {
+      fHists(nullptr),
+      fIDHead(),
+      fIDEntries(),
+      fIDs(),
+      fCandidates() {
   if (!fMinimalBooking) {
     fHists = new AliFemtoDreamPairCleanerHists(nTrackDecayChecks,
                                                nDecayDecayChecks);
@@ -57,25 +70,38 @@ AliFemtoDreamPairCleaner& AliFemtoDreamPairCleaner::operator=(
 void AliFemtoDreamPairCleaner::CleanTrackAndDecay(
     std::vector<AliFemtoDreamBasePart> *Tracks,
     std::vector<AliFemtoDreamBasePart> *Decay, int histnumber) {
+  //The track IDs are indexed once, a decay sharing a daughter with a track is
+  //rejected. The counter follows the former track by decay loop: for each
+  //decay, the daughters matching the first track (in order) sharing an ID.
   int counter = 0;
+  fIDHead.clear();
   for (auto itTrack = Tracks->begin(); itTrack != Tracks->end(); ++itTrack) {
-    //std::cout  << "New Track" << std::endl;
+    std::vector<int> IDTrack = itTrack->GetIDTracks();
+    if (IDTrack.size() > 0) {
+      fIDHead.insert(std::make_pair(IDTrack[0], int(itTrack - Tracks->begin())));
+    }
+  }
+  if (fIDHead.size() > 0) {
     for (auto itDecay = Decay->begin(); itDecay != Decay->end(); ++itDecay) {
-      if (itDecay->UseParticle()) {
-        //std::cout  << "New v0" << std::endl;
-        std::vector<int> IDTrack = itTrack->GetIDTracks();
-        std::vector<int> IDDaug = itDecay->GetIDTracks();
-        for (auto itIDs = IDDaug.begin(); itIDs != IDDaug.end(); ++itIDs) {
-          //std::cout <<"ID of Track: "<<IDTrack.at(0)<<" IDs of Daughter: "
-          //              <<*itIDs<<'\n';
-          if (*itIDs == IDTrack.at(0)) {
-            itDecay->SetUse(false);
-            counter++;
-          }
+      if (!itDecay->UseParticle()) {
+        continue;
+      }
+      std::vector<int> IDDaug = itDecay->GetIDTracks();
+      int firstTrack = -1;
+      int sharedID = 0;
+      for (auto itIDs = IDDaug.begin(); itIDs != IDDaug.end(); ++itIDs) {
+        auto itHead = fIDHead.find(*itIDs);
+        if (itHead != fIDHead.end()
+            && (firstTrack < 0 || itHead->second < firstTrack)) {
+          firstTrack = itHead->second;
+          sharedID = *itIDs;
         }
-      } else {
+      }
+      if (firstTrack < 0) {
         continue;
       }
+      itDecay->SetUse(false);
+      counter += std::count(IDDaug.begin(), IDDaug.end(), sharedID);
     }
   }
   if (!fMinimalBooking)
@@ -84,80 +110,90 @@ void AliFemtoDreamPairCleaner::CleanTrackAndDecay(
 void AliFemtoDreamPairCleaner::CleanDecayAndDecay(
     std::vector<AliFemtoDreamBasePart> *Decay1,
     std::vector<AliFemtoDreamBasePart> *Decay2, int histnumber) {
-  int counter = 0;
-  for (auto itDecay1 = Decay1->begin(); itDecay1 != Decay1->end(); ++itDecay1) {
-    if (itDecay1->UseParticle()) {
-      for (auto itDecay2 = Decay2->begin(); itDecay2 != Decay2->end();
-          ++itDecay2) {
-        if (itDecay2->UseParticle()) {
-          std::vector<int> IDDaug1 = itDecay1->GetIDTracks();
-          std::vector<int> IDDaug2 = itDecay2->GetIDTracks();
-          for (auto itID1s = IDDaug1.begin(); itID1s != IDDaug1.end();
-              ++itID1s) {
-            for (auto itID2s = IDDaug2.begin(); itID2s != IDDaug2.end();
-                ++itID2s) {
-              if (*itID1s == *itID2s) {
-                if (itDecay1->GetCPA() < itDecay2->GetCPA()) {
-                  itDecay1->SetUse(false);
-                  counter++;
-                } else {
-                  itDecay2->SetUse(false);
-                  counter++;
-                }
-              }
-            }
-          }
-        } else {
-          continue;
-        }
-      }
-    } else {
-      continue;
-    }
-  }
+  int counter = CleanSharedDaughters(Decay1, Decay2, false);
   if (!fMinimalBooking)
     fHists->FillDaughtersSharedDaughter(histnumber, counter);
 }
 
 void AliFemtoDreamPairCleaner::CleanDecay(
     std::vector<AliFemtoDreamBasePart> *Decay, int histnumber) {
+  int counter = CleanSharedDaughters(Decay, Decay, true);
+  if (!fMinimalBooking)
+    fHists->FillDaughtersSharedDaughter(histnumber, counter);
+}
+
+void AliFemtoDreamPairCleaner::IndexIDs(
+    std::vector<AliFemtoDreamBasePart> *Particles) {
+  fIDHead.clear();
+  fIDEntries.clear();
+  fIDs.resize(Particles->size());
+  //Filled backwards, such that the entries of an ID come in particle order
+  for (int iPart = Particles->size() - 1; iPart >= 0; --iPart) {
+    fIDs[iPart] = Particles->at(iPart).GetIDTracks();
+    for (auto itID = fIDs[iPart].begin(); itID != fIDs[iPart].end(); ++itID) {
+      auto itHead = fIDHead.insert(std::make_pair(*itID, -1)).first;
+      fIDEntries.push_back(std::make_pair(iPart, itHead->second));
+      itHead->second = fIDEntries.size() - 1;
+    }
+  }
+}
+
+int AliFemtoDreamPairCleaner::SharedIDs(const std::vector<int> &IDs1,
+                                        const std::vector<int> &IDs2) {
+  int nShared = 0;
+  for (auto itID1s = IDs1.begin(); itID1s != IDs1.end(); ++itID1s) {
+    nShared += std::count(IDs2.begin(), IDs2.end(), *itID1s);
+  }
+  return nShared;
+}
+
+int AliFemtoDreamPairCleaner::CleanSharedDaughters(
+    std::vector<AliFemtoDreamBasePart> *Decay1,
+    std::vector<AliFemtoDreamBasePart> *Decay2, bool SameList) {
+  //For each decay of the first list, only the decays of the second list
+  //sharing a daughter are visited, in the order of the former pairwise loop,
+  //keeping the one with the larger CPA. The counter is incremented for each
+  //shared daughter ID of a pair, as before.
   int counter = 0;
-  for (std::vector<AliFemtoDreamBasePart>::iterator itDecay1 = Decay->begin();
-      itDecay1 != Decay->end(); ++itDecay1) {
-    if (itDecay1->UseParticle()) {
-      //std::cout  << "New Particle 1" << std::endl;
-      for (auto itDecay2 = itDecay1 + 1; itDecay2 != Decay->end(); ++itDecay2) {
-        if (itDecay2->UseParticle()) {
-          //std::cout  << "New Particle 2" << std::endl;
-          std::vector<int> IDDaug1 = itDecay1->GetIDTracks();
-          std::vector<int> IDDaug2 = itDecay2->GetIDTracks();
-          for (auto itID1s = IDDaug1.begin(); itID1s != IDDaug1.end();
-              ++itID1s) {
-            for (auto itID2s = IDDaug2.begin(); itID2s != IDDaug2.end();
-                ++itID2s) {
-              //std::cout <<"ID of Daug v01: "<<*itID1s<<" ID of Daug v02: "
-              //                  <<*itID2s<<'\n';
-              if (*itID1s == *itID2s) {
-                if (itDecay1->GetCPA() < itDecay2->GetCPA()) {
-                  itDecay1->SetUse(false);
-                  counter++;
-                } else {
-                  itDecay2->SetUse(false);
-                  counter++;
-                }
-              }
-            }
-          }
-        } else {
-          continue;
+  IndexIDs(Decay2);
+  std::vector<int> IDDaug1;
+  for (auto itDecay1 = Decay1->begin(); itDecay1 != Decay1->end(); ++itDecay1) {
+    if (!itDecay1->UseParticle()) {
+      continue;
+    }
+    int iDecay1 = itDecay1 - Decay1->begin();
+    IDDaug1 = SameList ? fIDs[iDecay1] : itDecay1->GetIDTracks();
+    fCandidates.clear();
+    for (auto itID = IDDaug1.begin(); itID != IDDaug1.end(); ++itID) {
+      auto itHead = fIDHead.find(*itID);
+      if (itHead == fIDHead.end()) {
+        continue;
+      }
+      for (int iEntry = itHead->second; iEntry >= 0;
+          iEntry = fIDEntries[iEntry].second) {
+        if (!SameList || fIDEntries[iEntry].first > iDecay1) {
+          fCandidates.push_back(fIDEntries[iEntry].first);
         }
       }
-    } else {
-      continue;
+    }
+    std::sort(fCandidates.begin(), fCandidates.end());
+    fCandidates.erase(std::unique(fCandidates.begin(), fCandidates.end()),
+                      fCandidates.end());
+    for (auto itCand = fCandidates.begin(); itCand != fCandidates.end();
+        ++itCand) {
+      AliFemtoDreamBasePart &decay2 = Decay2->at(*itCand);
+      if (!decay2.UseParticle()) {
+        continue;
+      }
+      if (itDecay1->GetCPA() < decay2.GetCPA()) {
+        itDecay1->SetUse(false);
+      } else {
+        decay2.SetUse(false);
+      }
+      counter += SharedIDs(IDDaug1, fIDs[*itCand]);
     }
   }
-  if (!fMinimalBooking)
-    fHists->FillDaughtersSharedDaughter(histnumber, counter);
+  return counter;
 }
 
 void AliFemtoDreamPairCleaner::StoreParticle(
@@ -7,6 +7,7 @@
 
 #ifndef ALIFEMTODREAMPAIRCLEANER_H_
 #define ALIFEMTODREAMPAIRCLEANER_H_
+#include <unordered_map>
 #include <vector>
 #include "Rtypes.h"
 #include "AliFemtoDreamBasePart.h"
@@ -46,12 +47,25 @@ class AliFemtoDreamPairCleaner {
                              TVector3 Part2Momentum, int PDGPart2);
   int GetCounter() const {return fCounter;};
  private:
+  void IndexIDs(std::vector<AliFemtoDreamBasePart> *Particles);
+  int CleanSharedDaughters(std::vector<AliFemtoDreamBasePart> *Decay1,
+                           std::vector<AliFemtoDreamBasePart> *Decay2,
+                           bool SameList);
+  static int SharedIDs(const std::vector<int> &IDs1,
+                       const std::vector<int> &IDs2);
   double InvMassPair(TVector3 Part1, int PDG1, TVector3 Part2, int PDG2);
   double E2(int pdgCode, double Ptot2);
   bool fMinimalBooking;
   int fCounter;
   std::vector<std::vector<AliFemtoDreamBasePart>> fParticles;
-  AliFemtoDreamPairCleanerHists *fHists;ClassDef(AliFemtoDreamPairCleaner,3)
+  AliFemtoDreamPairCleanerHists *fHists;
+  // Index of the track IDs of one particle list: the first entry of each ID,
+  // and for each entry the particle index and the next entry with the same ID
+  std::unordered_map<int, int> fIDHead;  //!
+  std::vector<std::pair<int, int>> fIDEntries;  //!
+  std::vector<std::vector<int>> fIDs;  //!
+  std::vector<int> fCandidates;  //!
+  ClassDef(AliFemtoDreamPairCleaner,4)
 };
 
 inline double AliFemtoDreamPairCleaner::E2(int pdgCode, double Ptot2) {
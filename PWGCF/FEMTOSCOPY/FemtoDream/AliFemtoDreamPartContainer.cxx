@@ -46,9 +46,14 @@ void AliFemtoDreamPartContainer::SetEvent(
     std::vector<AliFemtoDreamBasePart> &Particles) {
   if (!(fPartBuffer.size() < fMixingDepth)) {
 //    std::cout << "Popping Front" << std::endl;
+    //Recycle the oldest slot, such that the memory of its particles is reused
+    fPartBuffer.push_back(std::vector<AliFemtoDreamBasePart>());
+    fPartBuffer.back().swap(fPartBuffer.front());
     fPartBuffer.pop_front();
+    fPartBuffer.back() = Particles;
+  } else {
+    fPartBuffer.push_back(Particles);
   }
-  fPartBuffer.push_back(Particles);
 //  std::cout << "PartBuffer Size: "<<fPartBuffer.size()<<'\t'<<"Input Size: "
 //      << Particles.size() << '\n';
   return;
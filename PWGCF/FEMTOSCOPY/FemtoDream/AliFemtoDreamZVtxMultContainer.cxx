@@ -15,7 +15,10 @@ ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
     : fPartContainer(0),
       fPDGParticleSpecies(0),
-      fWhichPairs(){
+      fWhichPairs(),
+      fPDGMasses(),
+      fMomenta(),
+      fMEMomenta() {
 }
 
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
@@ -23,10 +26,14 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
     : fPartContainer(conf->GetNParticles(),
                      AliFemtoDreamPartContainer(conf->GetMixingDepth())),
       fPDGParticleSpecies(conf->GetPDGCodes()),
-      fWhichPairs(conf->GetWhichPairs()){
+      fWhichPairs(conf->GetWhichPairs()),
+      fPDGMasses(),
+      fMomenta(),
+      fMEMomenta() {
   TDatabasePDG::Instance()->AddParticle("deuteron", "deuteron", 1.8756134,
                                         kTRUE, 0.0, 1, "Nucleus", 1000010020);
   TDatabasePDG::Instance()->AddAntiParticle("anti-deuteron", -1000010020);
+  ResolveMasses();
 }
 
 AliFemtoDreamZVtxMultContainer::~AliFemtoDreamZVtxMultContainer() {
@@ -56,23 +63,58 @@ void AliFemtoDreamZVtxMultContainer::SetEvent(
   }
   //  }
 }
+void AliFemtoDreamZVtxMultContainer::ResolveMasses() {
+  //The masses are looked up once per species instead of once per pair
+  fPDGMasses.resize(fPDGParticleSpecies.size());
+  for (unsigned int iSpec = 0; iSpec < fPDGParticleSpecies.size(); ++iSpec) {
+    TParticlePDG *pdgPart = TDatabasePDG::Instance()->GetParticle(
+        fPDGParticleSpecies[iSpec]);
+    fPDGMasses[iSpec] = pdgPart ? pdgPart->Mass() : 0.;
+  }
+}
+
+void AliFemtoDreamZVtxMultContainer::FillMomenta(
+    const std::vector<AliFemtoDreamBasePart> &Particles, double mass,
+    std::vector<TLorentzVector> &Momenta) const {
+  Momenta.resize(Particles.size());
+  auto itMom = Momenta.begin();
+  for (auto itPart = Particles.begin(); itPart != Particles.end();
+      ++itPart, ++itMom) {
+    const TVector3 mom = itPart->GetMomentum();
+    itMom->SetXYZM(mom.X(), mom.Y(), mom.Z(), mass);
+  }
+}
+
 void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
   int HistCounter = 0;
+  if (fPDGMasses.size() != fPDGParticleSpecies.size()) {
+    ResolveMasses();
+  }
+  //The four-momenta are built once per particle, the particles themselves are
+  //only referenced in the pair loop
+  fMomenta.resize(Particles.size());
+  for (unsigned int iSpec = 0; iSpec < Particles.size(); ++iSpec) {
+    FillMomenta(Particles[iSpec], fPDGMasses[iSpec], fMomenta[iSpec]);
+  }
   //First loop over all the different Species
   auto itPDGPar1 = fPDGParticleSpecies.begin();
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
       ++itSpec1) {
     auto itPDGPar2 = fPDGParticleSpecies.begin();
     itPDGPar2 += itSpec1 - Particles.begin();
+    std::vector<TLorentzVector> &Momenta1 = fMomenta[itSpec1 - Particles.begin()];
+    const double Mass1 = fPDGMasses[itSpec1 - Particles.begin()];
     for (auto itSpec2 = itSpec1; itSpec2 != Particles.end(); ++itSpec2) {
+      std::vector<TLorentzVector> &Momenta2 = fMomenta[itSpec2 - Particles.begin()];
+      const double Mass2 = fPDGMasses[itSpec2 - Particles.begin()];
       HigherMath->FillPairCounterSE(HistCounter, itSpec1->size(),
                                     itSpec2->size());
       //Now loop over the actual Particles and correlate them
       for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
           ++itPart1) {
-        AliFemtoDreamBasePart part1 = *itPart1;
+        TLorentzVector &PartOne = Momenta1[itPart1 - itSpec1->begin()];
         std::vector<AliFemtoDreamBasePart>::iterator itPart2;
         if (itSpec1 == itSpec2) {
           itPart2 = itPart1 + 1;
@@ -80,16 +122,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
           itPart2 = itSpec2->begin();
         }
         while (itPart2 != itSpec2->end()) {
-          AliFemtoDreamBasePart part2 = *itPart2;
-          TLorentzVector PartOne, PartTwo;
-          PartOne.SetXYZM(
-              itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-              itPart1->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
-          PartTwo.SetXYZM(
-              itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-              itPart2->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
+          TLorentzVector &PartTwo = Momenta2[itPart2 - itSpec2->begin()];
           float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
           if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
                                                RelativeK, true, false)) {
@@ -97,12 +130,12 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
             continue;
           }
           RelativeK = HigherMath->FillSameEvent(HistCounter, iMult, cent,
-                                                part1,
-                                                *itPDGPar1,
-                                                part2,
-                                                *itPDGPar2);
-          HigherMath->MassQA(HistCounter, RelativeK, *itPart1, *itPDGPar1,
-                                                     *itPart2, *itPDGPar2);
+                                                *itPart1,
+                                                Mass1,
+                                                *itPart2,
+                                                Mass2);
+          HigherMath->MassQA(HistCounter, RelativeK, *itPart1, Mass1,
+                                                     *itPart2, Mass2);
           HigherMath->SEDetaDPhiPlots(HistCounter, *itPart1, *itPDGPar1,
                                       *itPart2, *itPDGPar2, RelativeK, false);
           HigherMath->SEMomentumResolution(HistCounter, &(*itPart1), *itPDGPar1,
@@ -121,6 +154,10 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
   int HistCounter = 0;
+  if (fPDGMasses.size() != fPDGParticleSpecies.size()) {
+    ResolveMasses();
+  }
+  std::vector<TLorentzVector> Momenta1;
   auto itPDGPar1 = fPDGParticleSpecies.begin();
   //First loop over all the different Species
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
@@ -129,6 +166,8 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     //Particle1 + Particle2 == Particle2 + Particle 1
     int SkipPart = itSpec1 - Particles.begin();
     auto itPDGPar2 = fPDGParticleSpecies.begin() + SkipPart;
+    const double Mass1 = fPDGMasses[SkipPart];
+    FillMomenta(*itSpec1, Mass1, Momenta1);
     for (auto itSpec2 = fPartContainer.begin() + SkipPart;
         itSpec2 != fPartContainer.end(); ++itSpec2) {
       if (itSpec1->size() > 0) {
@@ -136,36 +175,36 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
                                              (int) itSpec2->GetMixingDepth());
       }
       for (int iDepth = 0; iDepth < (int) itSpec2->GetMixingDepth(); ++iDepth) {
-        std::vector<AliFemtoDreamBasePart> ParticlesOfEvent = itSpec2->GetEvent(
+        //The mixed event is paired in place in the buffer
+        std::vector<AliFemtoDreamBasePart> &ParticlesOfEvent = itSpec2->GetEvent(
             iDepth);
         HigherMath->FillPairCounterME(HistCounter, itSpec1->size(),
                                       ParticlesOfEvent.size());
+        if (itSpec1->size() == 0 || ParticlesOfEvent.size() == 0) {
+          continue;
+        }
+        const double Mass2 = fPDGMasses[itPDGPar2
+            - fPDGParticleSpecies.begin()];
+        FillMomenta(ParticlesOfEvent, Mass2, fMEMomenta);
         for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
             ++itPart1) {
+          TLorentzVector &PartOne = Momenta1[itPart1 - itSpec1->begin()];
           for (auto itPart2 = ParticlesOfEvent.begin();
               itPart2 != ParticlesOfEvent.end(); ++itPart2) {
-
-            TLorentzVector PartOne, PartTwo;
-            PartOne.SetXYZM(
-                itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-                itPart1->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
-            PartTwo.SetXYZM(
-                itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-                itPart2->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
+            TLorentzVector &PartTwo = fMEMomenta[itPart2
+                - ParticlesOfEvent.begin()];
             float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
             if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
                                                  RelativeK, false, false)) {
               continue;
             }
             RelativeK = HigherMath->FillMixedEvent(
-                HistCounter, iMult, cent, *itPart1, *itPDGPar1,
-                *itPart2, *itPDGPar2,
+                HistCounter, iMult, cent, *itPart1, Mass1,
+                *itPart2, Mass2,
                 AliFemtoDreamCollConfig::kNone);
 
-            HigherMath->MEMassQA(HistCounter, RelativeK, *itPart1, *itPDGPar1,
-                                                         *itPart2, *itPDGPar2);
+            HigherMath->MEMassQA(HistCounter, RelativeK, *itPart1, Mass1,
+                                                         *itPart2, Mass2);
             HigherMath->MEDetaDPhiPlots(HistCounter, *itPart1, *itPDGPar1,
                                         *itPart2, *itPDGPar2, RelativeK, false);
             HigherMath->MEMomentumResolution(HistCounter, &(*itPart1),
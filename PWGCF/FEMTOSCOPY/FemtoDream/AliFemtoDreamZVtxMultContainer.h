@@ -9,6 +9,7 @@
 #define ALIFEMTODREAMZVTXMULTCONTAINER_H_
 #include <vector>
 #include "Rtypes.h"
+#include "TLorentzVector.h"
 
 #include "AliFemtoDreamCollConfig.h"
 #include "AliFemtoDreamCorrHists.h"
@@ -36,6 +37,9 @@ class AliFemtoDreamZVtxMultContainer {
   float ComputeDeltaPhi(AliFemtoDreamBasePart &part1,
                         AliFemtoDreamBasePart &part2);
   void SetEvent(std::vector<std::vector<AliFemtoDreamBasePart>> &Particles);
+  void ResolveMasses();
+  void FillMomenta(const std::vector<AliFemtoDreamBasePart> &Particles,
+                   double mass, std::vector<TLorentzVector> &Momenta) const;
   TString ClassName() {
     return "zVtxMult Container";
   }
@@ -44,13 +48,19 @@ class AliFemtoDreamZVtxMultContainer {
   std::vector<AliFemtoDreamPartContainer> fPartContainer;
   std::vector<int> fPDGParticleSpecies;
   std::vector<unsigned int> fWhichPairs;
+  // masses of the particle species, resolved once from TDatabasePDG
+  std::vector<double> fPDGMasses;  //!
+  // four-momenta of the particles of the current event, per species, and of
+  // the mixed event being paired
+  std::vector<std::vector<TLorentzVector>> fMomenta;  //!
+  std::vector<TLorentzVector> fMEMomenta;  //!
 //  std::vector<bool> fRejPairs;
 //  bool fDoDeltaEtaDeltaPhiCut;
 //  float fDeltaEtaMax;
 //  float fDeltaPhiMax;
 //  float fDeltaPhiEtaMax;
 
-ClassDef(AliFemtoDreamZVtxMultContainer, 4)
+ClassDef(AliFemtoDreamZVtxMultContainer, 5)
   ;
 };
 
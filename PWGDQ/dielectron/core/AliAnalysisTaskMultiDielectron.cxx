@@ -59,6 +59,7 @@ AliAnalysisTaskMultiDielectron::AliAnalysisTaskMultiDielectron() :
   fPileUpRejTool(AliDielectronEventCuts::kSPD),
   fBeamEnergy(-1.),
   fRandomizeDaughters(kFALSE),
+  fUseTrackCache(kFALSE),
   fTriggerLogic(kAny),
   fTriggerAnalysis(0x0),
   fRequireTRDtrigger(kFALSE),
@@ -91,6 +92,7 @@ AliAnalysisTaskMultiDielectron::AliAnalysisTaskMultiDielectron(const char *name)
   fPileUpRejTool(AliDielectronEventCuts::kSPD),
   fBeamEnergy(-1.),
   fRandomizeDaughters(kFALSE),
+  fUseTrackCache(kFALSE),
   fTriggerLogic(kAny),
   fTriggerAnalysis(0x0),
   fRequireTRDtrigger(kFALSE),
@@ -367,6 +369,12 @@ void AliAnalysisTaskMultiDielectron::UserExec(Option_t *)
   AliDielectronPair::SetBeamEnergy(InputEvent(), fBeamEnergy);
   AliDielectronPair::SetRandomizeDaughters(fRandomizeDaughters);
 
+  // the track values are shared by all instances within this event
+  if (fUseTrackCache) {
+    AliDielectronVarManager::SetUseTrackCache(kTRUE);
+    AliDielectronVarManager::ClearTrackCache();
+  }
+
   //Process event in all AliDielectron instances
   //   TIter nextDie(&fListDielectron);
   //   AliDielectron *die=0;
@@ -393,6 +401,12 @@ void AliAnalysisTaskMultiDielectron::UserExec(Option_t *)
     ++idie;
   }
 
+  // do not leave the cache to other tasks using the var manager
+  if (fUseTrackCache) {
+    AliDielectronVarManager::SetUseTrackCache(kFALSE);
+    AliDielectronVarManager::ClearTrackCache();
+  }
+
   PostData(1, &fListHistos);
   PostData(2, &fListCF);
   PostData(3,fEventStat);
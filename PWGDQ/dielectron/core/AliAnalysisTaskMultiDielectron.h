@@ -60,6 +60,7 @@ public:
                       SetEvtVsTrkHistoExists(die->GetEvtVsTrkHistExists());}
   void SetBeamEnergy(Double_t beamEbyHand=-1.)  { fBeamEnergy=beamEbyHand;  }
   void SetRandomizeDaughters(Bool_t random=kTRUE) { fRandomizeDaughters=random; }
+  void SetUseTrackCache(Bool_t use=kTRUE)          { fUseTrackCache=use; }
 
   void SetRequireTRDTrigger(Bool_t requireTRDtrigger) {fRequireTRDtrigger = requireTRDtrigger;}
   void SetTRDTriggerClass(AliDielectronEventCuts::ETRDTriggerClass trdTriggerClass) {fTRDTriggerClass = trdTriggerClass;}
@@ -89,6 +90,7 @@ protected:
 
   Double_t fBeamEnergy;              // beam energy in GeV (set by hand)
   Bool_t   fRandomizeDaughters;      // shuffle daughters at pair creation (sorted according to pt by default, which affects PhivPair at least for Like Sign)
+  Bool_t   fUseTrackCache;           // compute the track values once per event for all AliDielectron instances
 
   ETriggerLogig fTriggerLogic;       // trigger logic: any or all bits need to be matching
 
@@ -110,6 +112,6 @@ protected:
   AliAnalysisTaskMultiDielectron(const AliAnalysisTaskMultiDielectron &c);
   AliAnalysisTaskMultiDielectron& operator= (const AliAnalysisTaskMultiDielectron &c);
 
-  ClassDef(AliAnalysisTaskMultiDielectron, 4); //Analysis Task handling multiple instances of AliDielectron
+  ClassDef(AliAnalysisTaskMultiDielectron, 5); //Analysis Task handling multiple instances of AliDielectron
 };
 #endif
@@ -68,6 +68,7 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectronSignalMC.h"
 #include "AliDielectronMixingHandler.h"
 #include "AliDielectronPairLegCuts.h"
+#include "AliDielectronVarCuts.h"
 #include "AliDielectronV0Cuts.h"
 #include "AliDielectronPID.h"
 #include "AliDielectronHistos.h"
@@ -161,6 +162,11 @@ AliDielectron::AliDielectron() :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fPairPreselection(kFALSE),
+  fPairPreselectionCheck(kFALSE),
+  fPreselMin(),
+  fPreselMax(),
+  fPreselExclude(),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -252,6 +258,11 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fPairPreselection(kFALSE),
+  fPairPreselectionCheck(kFALSE),
+  fPreselMin(),
+  fPreselMax(),
+  fPreselExclude(),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -366,6 +377,8 @@ void AliDielectron::Init()
     fPairFilter.AddCuts(trk2leg);
   }
 
+  InitPairPreselection();
+
   if (fCutQA) {
     fQAmonitor = new AliDielectronCutQA(Form("QAcuts_%s",GetName()),"QAcuts");
     fQAmonitor->AddTrackFilter(&fTrackFilter);
@@ -464,6 +477,19 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
 
 	AliDielectronPID::SetPIDCalibinPU(fPIDCalibinPU);
 
+  // cached track values can only be shared with instances which do not change the PID configuration
+  if (AliDielectronVarManager::GetUseTrackCache()) {
+    Bool_t hasPIDConfig = fPostPIDCntrdCorrArr || fPostPIDWdthCorrArr || fPostPIDCntrdCorr || fPostPIDWdthCorr ||
+                          fPostPIDCntrdCorrITS || fPostPIDWdthCorrITS || fPostPIDCntrdCorrTOF || fPostPIDWdthCorrTOF ||
+                          fPIDCalibinPU || fLegEffMap;
+    for(Int_t id=0; id<15 && !hasPIDConfig; id++){
+      for(Int_t ip=0; ip<15 && !hasPIDConfig; ip++){
+        hasPIDConfig = fPostPIDCntrdCorrPU[id][ip] || fPostPIDWdthCorrPU[id][ip];
+      }
+    }
+    AliDielectronVarManager::SetTrackCacheOwner(hasPIDConfig ? this : 0x0);
+  }
+
   // set event
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::SetEvent(ev1);
@@ -569,7 +595,11 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
 
   //process event mixing
   if (fMixing) {
+    // the mixed tracks are copies stored in the pools, do not cache them
+    const Bool_t useTrackCache = AliDielectronVarManager::GetUseTrackCache();
+    AliDielectronVarManager::SetUseTrackCache(kFALSE);
     fMixing->Fill(ev1,this);
+    AliDielectronVarManager::SetUseTrackCache(useTrackCache);
     //     FillHistograms(0x0,kTRUE);
   }
 
@@ -1460,6 +1490,16 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
 
+  // opening angle preselection from the KF legs,
+  // not possible if the cut decision is monitored for all pairs or if skipping SetTracks
+  // would change the random number sequence used to order the daughters
+  const Bool_t preselect=!fPreselMin.empty() && !fCfManagerPair && !(pairIndex==kEv1PM && fCutQA) &&
+                         !AliDielectronPair::GetRandomizeDaughters();
+  if (preselect) {
+    FillLegKinematics(0, arrTracks1, fPdgLeg1);
+    FillLegKinematics(1, arrTracks2, fPdgLeg2);
+  }
+
   AliDielectronPair *candidate=new AliDielectronPair;
   candidate->SetKFUsage(fUseKF);
 
@@ -1469,6 +1509,9 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
     Int_t end=ntrack2;
     if (arr1==arr2) end=itrack1;
     for (Int_t itrack2=0; itrack2<end; ++itrack2){
+      const Bool_t preselRejected=preselect && !IsPairPreselected(itrack1, itrack2);
+      if (preselRejected && !fPairPreselectionCheck) continue;
+
       //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
       candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
                            &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
@@ -1499,6 +1542,14 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
         fQAmonitor->Fill(cutMask,candidate);
       }
 
+      //the preselection must not reject pairs accepted by the pair filter
+      if (preselRejected) {
+        if (cutMask==selectedMask)
+          AliError(Form("%s: pair (%d,%d) of type %s rejected by the preselection but accepted by the pair filter",
+                        GetName(), itrack1, itrack2, PairClassName(pairIndex)));
+        continue;
+      }
+
       //apply cut
       if (cutMask!=selectedMask) continue;
 
@@ -1516,6 +1567,78 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   delete candidate;
 }
 
+//________________________________________________________________
+void AliDielectron::InitPairPreselection()
+{
+  //
+  // Collect the pair cuts on the opening angle, which are evaluated from the KF legs
+  // in FillPairArrays before the (KF) pair is built. The angle is calculated as in
+  // AliDielectronPair::OpeningAngle, i.e. after the transport of the legs to their point
+  // of closest approach, and thus takes the same value as in the pair filter.
+  // Only plain range cuts of AliDielectronVarCuts in the pair filter, which all have to be
+  // fulfilled, are used. The full pair cuts are applied afterwards.
+  //
+  fPreselMin.clear();
+  fPreselMax.clear();
+  fPreselExclude.clear();
+  if (!fPairPreselection || fNoPairing) return;
+
+  TIter nextCut(fPairFilter.GetCuts());
+  while (AliAnalysisCuts *cut = (AliAnalysisCuts*) nextCut()) {
+    if (cut->IsA()!=AliDielectronVarCuts::Class()) continue;
+    AliDielectronVarCuts *varCuts=static_cast<AliDielectronVarCuts*>(cut);
+    if (varCuts->GetCutType()!=AliDielectronVarCuts::kAll || varCuts->GetCutOnMCtruth()) continue;
+
+    for (Int_t iCut=0; iCut<varCuts->GetNCuts(); ++iCut){
+      Int_t var=-1;
+      Double_t cutMin=0., cutMax=0.;
+      Bool_t exclude=kFALSE;
+      if (!varCuts->GetRangeCut(iCut, var, cutMin, cutMax, exclude)) continue;
+      if (var!=AliDielectronVarManager::kOpeningAngle) continue;
+      fPreselMin.push_back(cutMin);
+      fPreselMax.push_back(cutMax);
+      fPreselExclude.push_back(exclude);
+    }
+  }
+  AliInfo(Form("%s: pair preselection with %d opening angle cuts%s", GetName(), (Int_t)fPreselMin.size(),
+               fPairPreselectionCheck ? " (check mode)" : ""));
+}
+
+//________________________________________________________________
+void AliDielectron::FillLegKinematics(Int_t leg, const TObjArray &arrTracks, Int_t pdg)
+{
+  //
+  // create the KF particles of the tracks in one of the arrays being paired,
+  // in the same way as AliDielectronPair::SetTracks
+  //
+  const Int_t ntrack=arrTracks.GetEntriesFast();
+  fLegKF[leg].resize(ntrack);
+  fLegPt[leg].resize(ntrack);
+  for (Int_t itrack=0; itrack<ntrack; ++itrack){
+    const AliVTrack *track=static_cast<const AliVTrack*>(arrTracks.UncheckedAt(itrack));
+    fLegKF[leg][itrack]=AliKFParticle(*track,pdg);
+    fLegPt[leg][itrack]=track->Pt();
+  }
+}
+
+//________________________________________________________________
+Bool_t AliDielectron::IsPairPreselected(Int_t itrack1, Int_t itrack2) const
+{
+  //
+  // check the opening angle preselection cuts for the pair of the two tracks,
+  // the daughters are ordered by pt as in AliDielectronPair::SetTracks
+  //
+  const AliKFParticle &kf1=fLegKF[0][itrack1];
+  const AliKFParticle &kf2=fLegKF[1][itrack2];
+  const Double_t angle=(fLegPt[0][itrack1]>fLegPt[1][itrack2]) ? kf1.GetAngle(kf2) : kf2.GetAngle(kf1);
+
+  for (UInt_t icut=0; icut<fPreselMin.size(); ++icut){
+    // same comparison as in AliDielectronVarCuts::IsSelected
+    if (((angle<fPreselMin[icut]) || (angle>fPreselMax[icut]))^fPreselExclude[icut]) return kFALSE;
+  }
+  return kTRUE;
+}
+
 //________________________________________________________________
 void AliDielectron::FillPairArrayTR()
 {
@@ -16,6 +16,8 @@
 //#####################################################
 
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <THnBase.h>
@@ -89,6 +91,10 @@ public:
   void SetNoPairing(Bool_t noPairing=kTRUE) { fNoPairing=noPairing; }
   void SetProcessLS(Bool_t doLS=kTRUE) { fProcessLS=doLS; }
   void SetUseKF(Bool_t useKF=kTRUE) { fUseKF=useKF; }
+  // reject pairs failing the pair cuts on kOpeningAngle before building the KF pair,
+  // the angle is computed from the KF legs exactly as in AliDielectronPair::OpeningAngle.
+  // With check, the rejected pairs are still built and an error is reported if the pair filter accepts one
+  void SetPairPreselection(Bool_t presel=kTRUE, Bool_t check=kFALSE) { fPairPreselection=presel; fPairPreselectionCheck=check; }
   const TObjArray* GetTrackArray(Int_t i) const {return (i>=0&&i<4)?&fTracks[i]:0;}
   const TObjArray* GetPairArray(Int_t i)  const {return (i>=0&&i<11)?
       static_cast<TObjArray*>(fPairCandidates->UncheckedAt(i)):0;}
@@ -289,11 +295,22 @@ private:
   Bool_t fDontClearArrays;      //Don't clear the arrays at the end of the Process function, needed for external use of pair and tracks
   Bool_t fEventProcess;         //Process event (or pair array)
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
+  Bool_t fPairPreselection;     // opening angle preselection of the pairs before the pair construction
+  Bool_t fPairPreselectionCheck; // build the pairs rejected by the preselection and compare with the pair filter
+
+  std::vector<Double_t> fPreselMin;     //! lower limits of the opening angle preselection cuts
+  std::vector<Double_t> fPreselMax;     //! upper limits of the opening angle preselection cuts
+  std::vector<Bool_t>   fPreselExclude; //! preselection cut rejects the range
+  std::vector<AliKFParticle> fLegKF[2]; //! KF particles of the legs in the two arrays being paired
+  std::vector<Double_t> fLegPt[2];      //! pt of the legs, orders the daughters as in AliDielectronPair::SetTracks
 
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
   void PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1, TObjArray &arrTracks2, const AliVEvent *ev, Int_t prefilterN);
   void FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev = 0x0);
+  void InitPairPreselection();
+  void FillLegKinematics(Int_t leg, const TObjArray &arrTracks, Int_t pdg);
+  Bool_t IsPairPreselected(Int_t itrack1, Int_t itrack2) const;
   void FillPairArrayTR();
 
   Int_t GetPairIndex(Int_t arr1, Int_t arr2) const {return arr1>=arr2?arr1*(arr1+1)/2+arr2:arr2*(arr2+1)/2+arr1;}
@@ -332,7 +349,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,19);
+  ClassDef(AliDielectron,20);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -113,10 +113,14 @@ Bool_t AliDielectronVarCuts::IsSelected(TObject* track)
     if (!track) return kFALSE;
   }
 
-  //Fill values
-  Double_t values[AliDielectronVarManager::kNMaxValues];
+  //Fill values, read them directly from the track cache if available
+  Double_t fillValues[AliDielectronVarManager::kNMaxValues];
   AliDielectronVarManager::SetFillMap(fUsedVars);
-  AliDielectronVarManager::Fill(track,values);
+  const Double_t *values=AliDielectronVarManager::GetTrackCacheValues(track);
+  if (!values) {
+    AliDielectronVarManager::Fill(track,fillValues);
+    values=fillValues;
+  }
   Double_t opResultValue = 0.;
 
   for (Int_t iCut=0; iCut<fNActiveCuts; ++iCut){
@@ -469,3 +473,22 @@ Int_t AliDielectronVarCuts::GetCutLimits(Int_t iCut, Double_t &cutMin, Double_t
 
   return iCut;
 }
+
+//________________________________________________________________________
+Bool_t AliDielectronVarCuts::GetRangeCut(Int_t iCut, Int_t &var, Double_t &cutMin, Double_t &cutMax, Bool_t &exclude) const
+{
+  //
+  // Return the variable and range of the cut at position iCut if it is a plain range cut on a single variable,
+  // i.e. not a bit cut, a cut with an object as upper limit or a cut on the combination of two variables
+  //
+  if (iCut < 0 || iCut > fNActiveCuts-1) return kFALSE;
+  if (fBitCut[iCut] || fUpperCut[iCut] || fVarOperation[iCut]!=kNone) return kFALSE;
+  // second variable of a combined cut
+  if (iCut > 0 && fVarOperation[iCut-1]!=kNone) return kFALSE;
+
+  var     = (Int_t)fActiveCuts[iCut];
+  cutMin  = fCutMin[iCut];
+  cutMax  = fCutMax[iCut];
+  exclude = fCutExclude[iCut];
+  return kTRUE;
+}
@@ -760,6 +760,14 @@ Bool_t          AliDielectronVarManager::fgEventPlaneACremoval = kFALSE;
 TString         AliDielectronVarManager::fgQnVectorNorm = "";
 Int_t           AliDielectronVarManager::fgCurrentRun = -1;
 Double_t        AliDielectronVarManager::fgData[AliDielectronVarManager::kNMaxValues] = {0.};
+Bool_t          AliDielectronVarManager::fgUseTrackCache     = kFALSE;
+const TObject*  AliDielectronVarManager::fgTrackCacheOwner   = 0x0;
+TBits*          AliDielectronVarManager::fgTrackCacheFillMap = 0x0;
+Int_t           AliDielectronVarManager::fgTrackCacheVersion = 0;
+TExMap          AliDielectronVarManager::fgTrackCacheIndex;
+std::vector<Double_t> AliDielectronVarManager::fgTrackCacheValues;
+std::vector<Int_t>    AliDielectronVarManager::fgTrackCacheRowVersion;
+Int_t           AliDielectronVarManager::fgTrackCacheRows    = 0;
 //________________________________________________________________
 AliDielectronVarManager::AliDielectronVarManager() :
   TNamed("AliDielectronVarManager","AliDielectronVarManager")
@@ -846,3 +854,83 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+//________________________________________________________________
+void AliDielectronVarManager::SetTrackCacheOwner(const TObject *owner)
+{
+  //
+  // Set the object whose PID configuration (post PID corrections, efficiency maps)
+  // is currently active. The cached values are dropped if they were filled with
+  // a different configuration
+  //
+  if (owner==fgTrackCacheOwner) return;
+  ClearTrackCache();
+  fgTrackCacheOwner=owner;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::ClearTrackCache()
+{
+  //
+  // Drop the cached track values, has to be called at the beginning of each event
+  //
+  fgTrackCacheIndex.Delete();
+  fgTrackCacheRows=0;
+}
+
+//________________________________________________________________
+const Double_t* AliDielectronVarManager::GetTrackCacheValues(const TObject *track)
+{
+  //
+  // Values of an ESD or AOD track of the current event. They are computed once per
+  // event for the union of all variables requested so far, such that the cuts, CF
+  // containers and histograms share the (PID) evaluation of the track.
+  // The event values and kRndm are refreshed at each call.
+  // Returns 0x0 if the cache is not used or the object cannot be cached.
+  // The returned pointer is only valid until the next call.
+  //
+  if (!fgUseTrackCache || !track || !fgFillMap) return 0x0;
+  if (track->IsA()!=AliESDtrack::Class() && track->IsA()!=AliAODTrack::Class()) return 0x0;
+  if (fgFillMap->GetNbits()>kNMaxValues) return 0x0;
+
+  // add the requested variables to the union, the rows are refilled if it grows
+  if (!fgTrackCacheFillMap) fgTrackCacheFillMap=new TBits(kNMaxValues);
+  Bool_t grown=kFALSE;
+  const UInt_t nbits=fgFillMap->GetNbits();
+  for (UInt_t i=fgFillMap->FirstSetBit(); i<nbits; i=fgFillMap->FirstSetBit(i+1)) {
+    if (fgTrackCacheFillMap->TestBitNumber(i)) continue;
+    fgTrackCacheFillMap->SetBitNumber(i);
+    grown=kTRUE;
+  }
+  if (grown) ++fgTrackCacheVersion;
+
+  const Long64_t key=(Long64_t)track;
+  Long64_t row=fgTrackCacheIndex.GetValue(key)-1;
+  if (row<0) {
+    row=fgTrackCacheRows++;
+    fgTrackCacheIndex.Add(key,row+1);
+    if ((Int_t)fgTrackCacheRowVersion.size()<fgTrackCacheRows) {
+      fgTrackCacheValues.resize(fgTrackCacheRows*kNMaxValues);
+      fgTrackCacheRowVersion.resize(fgTrackCacheRows);
+    }
+    fgTrackCacheRowVersion[row]=-1;
+  }
+
+  Double_t *values=&fgTrackCacheValues[row*kNMaxValues];
+  if (fgTrackCacheRowVersion[row]!=fgTrackCacheVersion) {
+    // fill with the union of the variables, without going through the cache again
+    TBits *fillMap=fgFillMap;
+    fgFillMap=fgTrackCacheFillMap;
+    fgUseTrackCache=kFALSE;
+    for (Int_t i=0; i<kNMaxValues; ++i) values[i]=0.;
+    Fill(track,values);
+    fgUseTrackCache=kTRUE;
+    fgFillMap=fillMap;
+    fgTrackCacheRowVersion[row]=fgTrackCacheVersion;
+  } else {
+    // the event data might have changed since the row was filled
+    for (Int_t i=kPairMax; i<kNMaxValues; ++i) values[i]=fgData[i];
+    if (Req(kRndm)) values[kRndm]=gRandom->Rndm();
+  }
+  return values;
+}
@@ -22,6 +22,8 @@
 //#                                                           #
 //#############################################################
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TProfile.h>
 #include <TProfile2D.h>
@@ -33,6 +35,7 @@
 #include <TDatabasePDG.h>
 #include <TKey.h>
 #include <TBits.h>
+#include <TExMap.h>
 #include <TRandom3.h>
 #include <TGrid.h>
 
@@ -828,6 +831,13 @@ public:
   static const char* GetValueUnit(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][2]:""; }
   static UInt_t GetValueType(const char* valname);
   static const Double_t* GetData() {return fgData;}
+
+  // per event cache of the track values, see GetTrackCacheValues
+  static void SetUseTrackCache(Bool_t use=kTRUE) { fgUseTrackCache=use; }
+  static Bool_t GetUseTrackCache() { return fgUseTrackCache; }
+  static void SetTrackCacheOwner(const TObject *owner);
+  static void ClearTrackCache();
+  static const Double_t* GetTrackCacheValues(const TObject *track);
   static AliVEvent* GetCurrentEvent() {return fgEvent;}
 
   static Double_t GetValue(ValueTypes var) {return fgData[var];}
@@ -896,6 +906,15 @@ private:
 
   static Double_t fgData[kNMaxValues];        //! data
 
+  static Bool_t           fgUseTrackCache;       //! cache the values of the tracks of the current event
+  static const TObject   *fgTrackCacheOwner;     //! object whose PID configuration the cached values belong to
+  static TBits           *fgTrackCacheFillMap;   //! union of the variables requested for the cached tracks
+  static Int_t            fgTrackCacheVersion;   //! increased each time the union of variables grows
+  static TExMap           fgTrackCacheIndex;     //! track pointer -> row+1 in the cache table
+  static std::vector<Double_t> fgTrackCacheValues;     //! cache table, kNMaxValues values per track
+  static std::vector<Int_t>    fgTrackCacheRowVersion; //! version of the union each row was filled with
+  static Int_t            fgTrackCacheRows;      //! number of rows in use
+
   AliDielectronVarManager(const AliDielectronVarManager &c);
   AliDielectronVarManager &operator=(const AliDielectronVarManager &c);
 
@@ -910,6 +929,13 @@ inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * cons
   // Main function to fill all available variables according to the type of particle
   //
   if (!object) return;
+  if (fgUseTrackCache) {
+    const Double_t *cached=GetTrackCacheValues(object);
+    if (cached) {
+      for (Int_t i=0; i<kNMaxValues; ++i) values[i]=cached[i];
+      return;
+    }
+  }
   if      (object->IsA() == AliESDtrack::Class())       FillVarESDtrack(static_cast<const AliESDtrack*>(object), values);
   else if (object->IsA() == AliAODTrack::Class())       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values);
   else if (object->IsA() == AliMCParticle::Class())     FillVarMCParticle(static_cast<const AliMCParticle*>(object), values);
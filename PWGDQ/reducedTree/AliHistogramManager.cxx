@@ -49,7 +49,13 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillPlanClasses(),
+  fFillPlanHandles(),
+  fFillPlanFirst(),
+  fFillPlanEntries(),
+  fFillPlanVars(),
+  fFillPlanValid(kFALSE)
 {
   //
   // Constructor
@@ -71,7 +77,13 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillPlanClasses(),
+  fFillPlanHandles(),
+  fFillPlanFirst(),
+  fFillPlanEntries(),
+  fFillPlanVars(),
+  fFillPlanValid(kFALSE)
 {
   //
   // Constructor
@@ -144,6 +156,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a histogram
   //
+  fFillPlanValid = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -286,6 +299,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a histogram
   //
+  fFillPlanValid = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -431,6 +445,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a multi-dimensional histogram THnF or THnFSparseF
   //
+  fFillPlanValid = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -484,6 +499,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a multi-dimensional histogram THnF or THnSparseF with equal or variable bin widths
   //
+  fFillPlanValid = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -624,148 +640,160 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
   //
   //  fill a class of histograms
   //
+  FillHistClass(GetHistClassHandle(className), values);
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassHandle(const Char_t* className) {
+  //
+  //  get the handle of a histogram class for FillHistClass(Int_t, Float_t*), -1 if the class does not exist
+  //  The handles stay valid when histograms are added later on
+  //
   THashList* hList = (THashList*)fMainList.FindObject(className);
-  if(!hList) {
-    /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
-    cout << "         Histogram list not filled" << endl; */
-    return;
-  }
-  if(!hList) {
-    return;
+  if(!hList) return -1;
+  
+  Long64_t handle = fFillPlanHandles.GetValue((Long64_t)hList)-1;
+  if(handle<0) {
+    handle = fFillPlanClasses.size();
+    fFillPlanClasses.push_back(hList);
+    fFillPlanHandles.Add((Long64_t)hList, handle+1);
+    fFillPlanValid = kFALSE;
   }
-    
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
-  Bool_t isSparse=kFALSE;
+  return handle;
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t handle, Float_t* values) {
+  //
+  //  fill a class of histograms using the pre-decoded fill plan
+  //
+  if(handle<0 || handle>=(Int_t)fFillPlanClasses.size()) return;
+  if(!fFillPlanValid) CompileFillPlan();
+  
   Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    if(isTHn && ((TString)h->ClassName()).Contains("Sparse")) isSparse = kTRUE;
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
+  for(Int_t i=fFillPlanFirst[handle]; i<fFillPlanFirst[handle+1]; ++i) {
+    const FillPlanEntry& entry = fFillPlanEntries[i];
+    const Int_t* vars = &fFillPlanVars[entry.fVarOffset];
+    const Bool_t weighted = (entry.fVarW>AliReducedVarManager::kNothing);
+    switch(entry.fKind) {
+      case kPlanTH1:
+        if(weighted) ((TH1*)entry.fHist)->Fill(values[vars[0]],values[entry.fVarW]);
+        else         ((TH1*)entry.fHist)->Fill(values[vars[0]]);
+        break;
+      case kPlanProfile:
+        if(weighted) ((TProfile*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[entry.fVarW]);
+        else         ((TProfile*)entry.fHist)->Fill(values[vars[0]],values[vars[1]]);
+        break;
+      case kPlanTH2:
+        if(weighted) ((TH2*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[entry.fVarW]);
+        else         ((TH2*)entry.fHist)->Fill(values[vars[0]],values[vars[1]]);
+        break;
+      case kPlanProfile2D:
+        if(weighted) ((TProfile2D*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[entry.fVarW]);
+        else         ((TProfile2D*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+        break;
+      case kPlanTH3:
+        if(weighted) ((TH3*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[entry.fVarW]);
+        else         ((TH3*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+        break;
+      case kPlanProfile3D:
+        if(weighted) ((TProfile3D*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]],values[entry.fVarW]);
+        else         ((TProfile3D*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]]);
+        break;
+      case kPlanTHn:
+        for(Int_t idim=0;idim<entry.fNVars;++idim) fillValues[idim] = values[vars[idim]];
+        if(weighted) ((THnBase*)entry.fHist)->Fill(fillValues,values[entry.fVarW]);
+        else         ((THnBase*)entry.fHist)->Fill(fillValues);
+        break;
+      default:
+        break;
     }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
-          case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
-          case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
-          case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
-          default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        if (isSparse) {
-          allVarsGood &= fUsedVars[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-        } else {
-          allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        }
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW]) {
-            if (isSparse) ((THnSparseF*)h)->Fill(fillValues,values[varW]);
-            else          ((THnF*)h)->Fill(fillValues,values[varW]);
-          }
-        }
-        else {
-          if (isSparse) ((THnSparseF*)h)->Fill(fillValues);
-          else          ((THnF*)h)->Fill(fillValues);
-        }
-      }
+  }
+}
+
+//__________________________________________________________________
+void AliHistogramManager::CompileFillPlan() {
+  //
+  //  decode the histograms of all the registered histogram classes into the fill plan
+  //
+  fFillPlanFirst.clear();
+  fFillPlanEntries.clear();
+  fFillPlanVars.clear();
+  for(UInt_t ic=0; ic<fFillPlanClasses.size(); ++ic) {
+    fFillPlanFirst.push_back(fFillPlanEntries.size());
+    TIter next(fFillPlanClasses[ic]);
+    TObject* h=0x0;
+    while((h=next())) AddToFillPlan(h);
+  }
+  fFillPlanFirst.push_back(fFillPlanEntries.size());
+  fFillPlanValid = kTRUE;
+}
+
+//__________________________________________________________________
+void AliHistogramManager::AddToFillPlan(TObject* h) {
+  //
+  //  decode the variables and the type of a histogram from its unique IDs, see AddHistogram()
+  //  histograms using variables which are not filled are not added
+  //
+  Int_t uid = h->GetUniqueID();
+  Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+  Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+  Int_t thnDim = 0;
+  if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
+  
+  uid = (uid-(uid%100))/100;
+  Int_t varT = -1;
+  Int_t varW = -1;
+  if(uid>0) {
+    varW = uid%(fNVars+1)-1;
+    if(varW==0) varW=AliReducedVarManager::kNothing;
+    uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+    if(uid>0) varT = uid - 1;
+  }
+  if(varW>AliReducedVarManager::kNothing && !fUsedVars[varW]) return;
+  
+  FillPlanEntry entry;
+  entry.fHist = h;
+  entry.fVarOffset = fFillPlanVars.size();
+  entry.fVarW = varW;
+  
+  Int_t vars[20];
+  Int_t nVars = 0;
+  if(isTHn) {
+    if(thnDim>20) return;
+    entry.fKind = kPlanTHn;
+    for(Int_t idim=0;idim<thnDim;++idim) vars[nVars++] = ((THnBase*)h)->GetAxis(idim)->GetUniqueID();
+  }
+  else {
+    TH1* h1 = (TH1*)h;
+    vars[nVars++] = h1->GetXaxis()->GetUniqueID();
+    switch(h1->GetDimension()) {
+      case 1:
+        entry.fKind = (isProfile ? kPlanProfile : kPlanTH1);
+        if(isProfile) vars[nVars++] = h1->GetYaxis()->GetUniqueID();
+        break;
+      case 2:
+        entry.fKind = (isProfile ? kPlanProfile2D : kPlanTH2);
+        vars[nVars++] = h1->GetYaxis()->GetUniqueID();
+        if(isProfile) vars[nVars++] = h1->GetZaxis()->GetUniqueID();
+        break;
+      case 3:
+        entry.fKind = (isProfile ? kPlanProfile3D : kPlanTH3);
+        vars[nVars++] = h1->GetYaxis()->GetUniqueID();
+        vars[nVars++] = h1->GetZaxis()->GetUniqueID();
+        if(isProfile) vars[nVars++] = varT;
+        break;
+      default:
+        return;
     }
   }
+  for(Int_t i=0;i<nVars;++i) {
+    if(vars[i]<0 || vars[i]>=AliReducedVarManager::kNVars || !fUsedVars[vars[i]]) return;
+  }
+  
+  entry.fNVars = nVars;
+  for(Int_t i=0;i<nVars;++i) fFillPlanVars.push_back(vars[i]);
+  fFillPlanEntries.push_back(entry);
 }
 
 //__________________________________________________________________
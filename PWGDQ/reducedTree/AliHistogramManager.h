@@ -8,11 +8,14 @@
 #ifndef ALIHISTOGRAMMANAGER_H
 #define ALIHISTOGRAMMANAGER_H
 
+#include <vector>
+
 #include <TString.h>
 #include <TObject.h>
 #include <THn.h>
 #include <TList.h>
 #include <THashList.h>
+#include <TExMap.h>
 
 #include "AliReducedVarManager.h"
 
@@ -69,6 +72,9 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  // fill plan: the histogram classes are resolved once into integer handles, to be used in the event loop
+  Int_t GetHistClassHandle(const Char_t* className);
+  void FillHistClass(Int_t handle, Float_t* values);
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -108,7 +114,28 @@ class AliHistogramManager : public TObject {
   
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
   
-  ClassDef(AliHistogramManager, 4)
+  // pre-decoded histogram of the fill plan
+  enum EFillPlanKind {
+    kPlanTH1=0, kPlanProfile, kPlanTH2, kPlanProfile2D, kPlanTH3, kPlanProfile3D, kPlanTHn
+  };
+  struct FillPlanEntry {
+    TObject* fHist;        // histogram
+    Int_t    fKind;        // one of EFillPlanKind
+    Int_t    fVarOffset;   // first variable of the histogram in fFillPlanVars
+    Int_t    fNVars;       // number of variables (x,y,z,t or THn axes)
+    Int_t    fVarW;        // weight variable, or AliReducedVarManager::kNothing
+  };
+  std::vector<THashList*>     fFillPlanClasses;   //! histogram class lists, indexed by handle
+  TExMap                      fFillPlanHandles;   //! histogram class list -> handle+1
+  std::vector<Int_t>          fFillPlanFirst;     //! first entry of each handle in fFillPlanEntries, size is number of handles+1
+  std::vector<FillPlanEntry>  fFillPlanEntries;   //! pre-decoded histograms of all classes
+  std::vector<Int_t>          fFillPlanVars;      //! variables of all histograms
+  Bool_t                      fFillPlanValid;     //! the plan is up to date with the booked histograms
+  
+  void CompileFillPlan();
+  void AddToFillPlan(TObject* h);
+  
+  ClassDef(AliHistogramManager, 5)
 };
 
 #endif
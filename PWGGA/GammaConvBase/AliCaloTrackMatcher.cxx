@@ -27,6 +27,7 @@
 #include "AliESDEvent.h"
 #include "AliESDtrack.h"
 #include "AliESDtrackCuts.h"
+#include "AliExternalTrackParam.h"
 #include "AliInputEventHandler.h"
 #include "AliTrackerBase.h"
 #include "AliV0ReaderV1.h"
@@ -35,7 +36,9 @@
 #include "TChain.h"
 #include "TH1F.h"
 #include "TF1.h"
+#include "TTree.h"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <utility>
@@ -44,6 +47,90 @@ class iostream;
 
 using namespace std;
 
+namespace {
+  // Tracks propagated to the calorimeter surface. The propagation only depends on the track, the surface
+  // (EMCal/DCal or PHOS) and the mass hypothesis, it is therefore shared by all matchers (cluster types,
+  // running modes, correction task settings) processing the same event.
+  struct PropagatedTrack {
+    PropagatedTrack() : fDone(kFALSE), fPropagated(kFALSE), fHasPosition(kFALSE), fParam(), fEta(0), fPhi(0) {fPosition[0] = fPosition[1] = fPosition[2] = 0.;}
+    Bool_t                fDone;         // propagation tried for this event
+    Bool_t                fPropagated;   // propagation to the surface successful
+    Bool_t                fHasPosition;  // global position at the surface available
+    AliExternalTrackParam fParam;        // track parameters at the surface
+    Float_t               fEta;          // eta at the EMCal surface
+    Float_t               fPhi;          // phi at the EMCal surface
+    Double_t              fPosition[3];  // global position at the surface
+  };
+
+  struct PropagationCache {
+    PropagationCache() : fEvent(0x0), fTree(0x0), fEntry(-1), fNTracks(-1), fPHOS(kFALSE), fMass(0), fTracks() {}
+    AliVEvent*              fEvent;      // event, tree and entry identifying the event the cache was filled for
+    TTree*                  fTree;
+    Long64_t                fEntry;
+    Int_t                   fNTracks;
+    Bool_t                  fPHOS;       // propagated to PHOS (460 cm) or EMCal (440 cm)
+    Double_t                fMass;       // mass hypothesis used for the propagation
+    vector<PropagatedTrack> fTracks;     // per position of the track in the event
+  };
+
+  vector<PropagationCache> gPropagationCaches;
+
+  PropagationCache& GetPropagationCache(AliVEvent *event, Bool_t toPHOS, Double_t mass){
+    AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+    TTree *tree = mgr ? mgr->GetTree() : 0x0;
+    Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+    Int_t nTracks = event->GetNumberOfTracks();
+
+    PropagationCache *cache = 0x0;
+    for(UInt_t i = 0; i < gPropagationCaches.size(); i++){
+      if(gPropagationCaches[i].fPHOS == toPHOS && gPropagationCaches[i].fMass == mass) cache = &gPropagationCaches[i];
+    }
+    if(!cache){
+      gPropagationCaches.push_back(PropagationCache());
+      cache = &gPropagationCaches.back();
+      cache->fPHOS = toPHOS;
+      cache->fMass = mass;
+    }
+    // without an entry number the event cannot be identified, the propagations are then redone by every matcher
+    if(entry < 0 || cache->fEvent != event || cache->fTree != tree || cache->fEntry != entry || cache->fNTracks != nTracks){
+      cache->fEvent = event;
+      cache->fTree = tree;
+      cache->fEntry = entry;
+      cache->fNTracks = nTracks;
+      cache->fTracks.resize(nTracks);
+      for(Int_t i = 0; i < nTracks; i++) cache->fTracks[i].fDone = kFALSE;
+    }
+    return *cache;
+  }
+
+  const PropagatedTrack& GetPropagatedTrack(PropagationCache &cache, Int_t itr, AliESDtrack *esdt, AliAODTrack *aodt, Bool_t toPHOS, Double_t mass){
+    PropagatedTrack &track = cache.fTracks[itr];
+    if(track.fDone) return track;
+    track.fDone = kTRUE;
+    track.fPropagated = kFALSE;
+    track.fHasPosition = kFALSE;
+
+    if(esdt){
+      track.fParam = *(esdt->GetInnerParam());
+    }else{
+      Double_t xyz[3] = {0}, pxpypz[3] = {0}, cv[21] = {0};
+      aodt->GetPxPyPz(pxpypz);
+      aodt->GetXYZ(xyz);
+      aodt->GetCovarianceXYZPxPyPz(cv);
+      track.fParam = AliExternalTrackParam(xyz,pxpypz,cv,aodt->Charge());
+    }
+
+    if(!toPHOS){
+      Float_t pt = 0;
+      if(!AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&track.fParam, 440., mass, 20., track.fEta, track.fPhi, pt)) return track;
+    }else{
+      if(!AliTrackerBase::PropagateTrackToBxByBz(&track.fParam, 460., mass, 20, kTRUE, 0.8, -1)) return track;
+    }
+    track.fPropagated = kTRUE;
+    track.fHasPosition = track.fParam.GetXYZ(track.fPosition);
+    return track;
+  }
+}
 
 ClassImp(AliCaloTrackMatcher)
 
@@ -60,11 +147,23 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
   fArrClusters(NULL),
-  fMapTrackToCluster(),
-  fMapClusterToTrack(),
-  fNEntries(1),
+  fEventClusters(),
+  fEventClusterPos(),
   fVectorDeltaEtaDeltaPhi(0),
-  fMap_TrID_ClID_ToIndex(),
+  fMatchTrackKeys(),
+  fMatchTrackIDs(),
+  fMatchClusterIDs(),
+  fMatchResidual(),
+  fMatchOrder(),
+  fTrackKeys(),
+  fTrackOffsets(),
+  fTrackToCluster(),
+  fClusterKeys(),
+  fClusterOffsets(),
+  fClusterToTrack(),
+  fResidualIndex(),
+  fTrackIDToPosition(),
+  fTrackPositionsEvent(0x0),
   fSecMapTrackToCluster(),
   fSecMapClusterToTrack(),
   fSecNEntries(1),
@@ -87,10 +186,11 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
 //________________________________________________________________________
 AliCaloTrackMatcher::~AliCaloTrackMatcher(){
     // default deconstructor
-    fMapTrackToCluster.clear();
-    fMapClusterToTrack.clear();
+    fEventClusters.clear();
     fVectorDeltaEtaDeltaPhi.clear();
-    fMap_TrID_ClID_ToIndex.clear();
+    fTrackToCluster.clear();
+    fClusterToTrack.clear();
+    fResidualIndex.clear();
 
     fSecMapTrackToCluster.clear();
     fSecMapClusterToTrack.clear();
@@ -109,10 +209,11 @@ AliCaloTrackMatcher::~AliCaloTrackMatcher(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::Terminate(Option_t *){
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
   fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
+  fMatchTrackKeys.clear();
+  fMatchTrackIDs.clear();
+  fMatchClusterIDs.clear();
+  BuildMatchTables();
 
   fSecMapTrackToCluster.clear();
   fSecMapClusterToTrack.clear();
@@ -168,11 +269,11 @@ void AliCaloTrackMatcher::UserCreateOutputObjects(){
 //________________________________________________________________________
 void AliCaloTrackMatcher::Initialize(Int_t runNumber){
   // Initialize function to be called once before analysis
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
-  fNEntries = 1;
   fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
+  fMatchTrackKeys.clear();
+  fMatchTrackIDs.clear();
+  fMatchClusterIDs.clear();
+  BuildMatchTables();
 
   fSecMapTrackToCluster.clear();
   fSecMapClusterToTrack.clear();
@@ -200,6 +301,8 @@ void AliCaloTrackMatcher::UserExec(Option_t *){
 
   //DebugV0Matching();
 
+  fTrackPositionsEvent = 0x0;
+
   // do processing only for EMCal (1), DCal (3) or PHOS (2) clusters, otherwise do nothing
   if(fClusterType == 1 || fClusterType == 2 || fClusterType == 3 || fClusterType == 4){
     Initialize(fInputEvent->GetRunNumber());
@@ -288,14 +391,35 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
   }
 
+  // clusters in the calorimeter of this matcher, collected once per event instead of once per track
+  fEventClusters.clear();
+  fEventClusterPos.clear();
+  for(Int_t iclus=0;iclus < nClus;iclus++){
+    AliVCluster* cluster = NULL;
+    if(fArrClusters) cluster = dynamic_cast<AliVCluster*>(fArrClusters->At(iclus));
+    else cluster = event->GetCaloCluster(iclus);
+    if (!cluster) continue;
+    if((fClusterType == 1 || fClusterType == 3 || fClusterType == 4) && !cluster->IsEMCAL()) continue;
+    if(fClusterType == 2 && !cluster->IsPHOS()) continue;
+    Float_t clsPos[3] = {0.,0.,0.};
+    cluster->GetPosition(clsPos);
+    fEventClusters.push_back(cluster);
+    fEventClusterPos.insert(fEventClusterPos.end(),clsPos,clsPos+3);
+  }
+  const Int_t nEventClusters = fEventClusters.size();
+
+  Bool_t toPHOS = (fClusterType == 2);
+  PropagationCache &propagationCache = GetPropagationCache(event, toPHOS, fMassHypothesis);
+
   for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
-    AliExternalTrackParam *trackParam = 0;
     AliVTrack *inTrack = 0x0;
+    AliESDtrack *esdt = 0x0;
+    AliAODTrack *aodt = 0x0;
     if(esdev){
       inTrack = esdev->GetTrack(itr);
       if(!inTrack) continue;
       FillfHistControlMatches(0.,inTrack->Pt());
-      AliESDtrack *esdt = dynamic_cast<AliESDtrack*>(inTrack);
+      esdt = dynamic_cast<AliESDtrack*>(inTrack);
 
       if(fRunningMode == 0){
         if(TMath::Abs(inTrack->Eta())>0.8 && (fClusterType == 1 || fClusterType == 3  || fClusterType == 4)){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
@@ -312,14 +436,12 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
         }
       }
 
-      const AliExternalTrackParam *in = esdt->GetInnerParam();
-      if (!in){AliDebug(2, "Could not get InnerParam of Track, continue"); FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-      trackParam = new AliExternalTrackParam(*in);
+      if (!esdt->GetInnerParam()){AliDebug(2, "Could not get InnerParam of Track, continue"); FillfHistControlMatches(1.,inTrack->Pt()); continue;}
     } else if(aodev) {
       inTrack = dynamic_cast<AliVTrack*>(aodev->GetTrack(itr));
       if(!inTrack) continue;
       FillfHistControlMatches(0.,inTrack->Pt());
-      AliAODTrack *aodt = dynamic_cast<AliAODTrack*>(inTrack);
+      aodt = dynamic_cast<AliAODTrack*>(inTrack);
 
       if(fRunningMode == 0){
         if(inTrack->GetID()<0){FillfHistControlMatches(1.,inTrack->Pt()); continue;} // Avoid double counting of tracks
@@ -338,11 +460,6 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
         }
       }
 
-      Double_t xyz[3] = {0}, pxpypz[3] = {0}, cv[21] = {0};
-      aodt->GetPxPyPz(pxpypz);
-      aodt->GetXYZ(xyz);
-      aodt->GetCovarianceXYZPxPyPz(cv);
-
       // check for EMC tracks already propagated tracks are out of bounds
       if (fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
         if( TMath::Abs(aodt->GetTrackEtaOnEMCal()) > 0.75 ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
@@ -357,66 +474,50 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
           if( fClusterType == 4 && ( aodt->GetTrackPhiOnEMCal() < 70*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 190*TMath::DegToRad()) && ( aodt->GetTrackPhiOnEMCal() < 250*TMath::DegToRad() || aodt->GetTrackPhiOnEMCal() > 340*TMath::DegToRad()) ){FillfHistControlMatches(1.,inTrack->Pt()); continue;}
         }
       }
-      trackParam = new AliExternalTrackParam(xyz,pxpypz,cv,aodt->Charge());
     }
 
-    if (!trackParam) {AliError("Could not get TrackParameters, continue"); FillfHistControlMatches(1.,inTrack->Pt()); continue;}
-    AliExternalTrackParam emcParam(*trackParam);
-    Float_t eta, phi, pt;
-
-    //propagate tracks to emc surfaces
+    //propagate tracks to emc surfaces, or take them from the propagations done for this event by another matcher
+    const PropagatedTrack &propTrack = GetPropagatedTrack(propagationCache, itr, esdt, aodt, toPHOS, fMassHypothesis);
+    if(!propTrack.fPropagated){
+      FillfHistControlMatches(2.,inTrack->Pt());
+      continue;
+    }
     if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
-      if (!AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 440., fMassHypothesis , 20., eta, phi, pt)) {
-        delete trackParam;
-        FillfHistControlMatches(2.,inTrack->Pt());
-        continue;
-      }
+      Float_t eta = propTrack.fEta;
+      Float_t phi = propTrack.fPhi;
       if( TMath::Abs(eta) > 0.75 ) {
-        delete trackParam;
         FillfHistControlMatches(3.,inTrack->Pt());
         continue;
       }
       // Save some time and memory in case of no DCal present
       if( fClusterType == 1 && nModules < 13 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())){
-        delete trackParam;
         FillfHistControlMatches(3.,inTrack->Pt());
         continue;
       }
       // Save some time and memory in case of run2
       if( nModules > 12 ){
         if (fClusterType == 3 && ( phi < 250*TMath::DegToRad() || phi > 340*TMath::DegToRad())){
-          delete trackParam;
           FillfHistControlMatches(3.,inTrack->Pt());
           continue;
         }
         if( fClusterType == 1 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())){
-          delete trackParam;
           FillfHistControlMatches(3.,inTrack->Pt());
           continue;
         }
         if( fClusterType == 4 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())
                               && ( phi < 250*TMath::DegToRad() || phi > 340*TMath::DegToRad())){
-          delete trackParam;
           FillfHistControlMatches(3.,inTrack->Pt());
           continue;
         }
       }
     }else if(fClusterType == 2){
-      if( !AliTrackerBase::PropagateTrackToBxByBz(&emcParam, 460., fMassHypothesis, 20, kTRUE, 0.8, -1)){
-        delete trackParam;
-        FillfHistControlMatches(2.,inTrack->Pt());
-        continue;
-      }
-      Double_t trkPos[3] = {0,0,0};
-      if(emcParam.GetXYZ(trkPos)){
-        TVector3 trkPosVec(trkPos[0],trkPos[1],trkPos[2]);
+      if(propTrack.fHasPosition){
+        TVector3 trkPosVec(propTrack.fPosition[0],propTrack.fPosition[1],propTrack.fPosition[2]);
         if (TMath::Abs(trkPosVec.Eta()) > 0.25 ){
-          delete trackParam;
           FillfHistControlMatches(3.,inTrack->Pt());
           continue;
         }
         if (trkPosVec.Phi() < 230*TMath::DegToRad() || trkPosVec.Phi() > 350*TMath::DegToRad() ){
-          delete trackParam;
           FillfHistControlMatches(3.,inTrack->Pt());
           continue;
         }
@@ -424,63 +525,28 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
 
     Float_t dEta=-999, dPhi=-999;
-    Float_t clsPos[3] = {0.,0.,0.};
-    Double_t exPos[3] = {0.,0.,0.};
-    if (!emcParam.GetXYZ(exPos)){
-      delete trackParam;
+    if (!propTrack.fHasPosition){
       FillfHistControlMatches(2.,inTrack->Pt());
       continue;
     }
+    const Double_t *exPos = propTrack.fPosition;
 
-    // cout << inTrack->GetID() << " - " << trackParam << endl;
-    // cout << "eta/phi: " << eta << ", " << phi << endl;
-    // cout << "nClus: " << nClus << endl;
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
-      AliVCluster* cluster = NULL;
-      if(fArrClusters){
-        if(esdev){
-          if(fArrClusters)
-            cluster = new AliESDCaloCluster(*(AliESDCaloCluster*)fArrClusters->At(iclus));
-        } else if(aodev){
-          if(fArrClusters)
-            cluster = new AliAODCaloCluster(*(AliAODCaloCluster*)fArrClusters->At(iclus));
-        }
-      }
-      else
-        cluster = event->GetCaloCluster(iclus);
-      if (!cluster){
-        if(fArrClusters) delete cluster;
-        continue;
-      }
-      // cout << "-------------------------LOOPING: " << iclus << ", " << cluster->GetID() << endl;
-      cluster->GetPosition(clsPos);
+    for(Int_t iclus=0;iclus < nEventClusters;iclus++){
+      AliVCluster* cluster = fEventClusters[iclus];
+      const Float_t *clsPos = &fEventClusterPos[3*iclus];
       Double_t dR = TMath::Sqrt(TMath::Power(exPos[0]-clsPos[0],2)+TMath::Power(exPos[1]-clsPos[1],2)+TMath::Power(exPos[2]-clsPos[2],2));
-      //cout << "dR: " << dR << endl;
-      if (dR > fMatchingWindow){
-        if(fArrClusters) delete cluster;
-        continue;
-      }
+      if (dR > fMatchingWindow) continue;
       Double_t clusterR = TMath::Sqrt( clsPos[0]*clsPos[0] + clsPos[1]*clsPos[1] );
-      AliExternalTrackParam trackParamTmp(emcParam);//Retrieve the starting point every time before the extrapolation
+      AliExternalTrackParam trackParamTmp(propTrack.fParam);//Retrieve the starting point every time before the extrapolation
       if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
-        if (!cluster->IsEMCAL()){
-          if(fArrClusters) delete cluster;
-          continue;
-        }
         if(!AliEMCALRecoUtils::ExtrapolateTrackToCluster(&trackParamTmp, cluster, fMassHypothesis, 5., dEta, dPhi)){
           FillfHistControlMatches(4.,inTrack->Pt());
-          if(fArrClusters) delete cluster;
           continue;
         }
       }else if(fClusterType == 2){
-        if (!cluster->IsPHOS()){
-          if(fArrClusters) delete cluster;
-          continue;
-        }
         if(!AliTrackerBase::PropagateTrackToBxByBz(&trackParamTmp, clusterR, fMassHypothesis, 5., kTRUE, 0.8, -1)){
           FillfHistControlMatches(4.,inTrack->Pt());
-          if(fArrClusters) delete cluster;
           continue;
         }
         Double_t trkPos[3] = {0,0,0};
@@ -492,33 +558,102 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       }
 
       Float_t dR2 = dPhi*dPhi + dEta*dEta;
-
-      //cout << dEta << " - " << dPhi << " - " << dR2 << endl;
-      if(dR2 > fMatchingResidual){
-        if(fArrClusters) delete cluster;
-        continue;
-      }
+      if(dR2 > fMatchingResidual) continue;
       nClusterMatchesToTrack++;
-      if(aodev){
-        fMapTrackToCluster.insert(make_pair(itr,cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),itr));
-      }else{
-        fMapTrackToCluster.insert(make_pair(inTrack->GetID(),cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),inTrack->GetID()));
-      }
+      fMatchTrackKeys.push_back(aodev ? itr : inTrack->GetID());
+      fMatchTrackIDs.push_back(inTrack->GetID());
+      fMatchClusterIDs.push_back(cluster->GetID());
       fVectorDeltaEtaDeltaPhi.push_back(make_pair(dEta,dPhi));
-      fMap_TrID_ClID_ToIndex[make_pair(inTrack->GetID(),cluster->GetID())] = fNEntries++;
-      if( (Int_t)fVectorDeltaEtaDeltaPhi.size() != (fNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
-      if(fArrClusters) delete cluster;
     }
     if(nClusterMatchesToTrack == 0) FillfHistControlMatches(5.,inTrack->Pt());
     else FillfHistControlMatches(6.,inTrack->Pt());
-    delete trackParam;
   }
 
+  BuildMatchTables();
   return;
 }
 
+//________________________________________________________________________
+void AliCaloTrackMatcher::BuildMatchTables(){
+  // residual index per (trackID,clusterID), for a pair matched twice the last match is kept
+  const Int_t nMatches = fVectorDeltaEtaDeltaPhi.size();
+  fResidualIndex.clear();
+  for(Int_t i=0;i<nMatches;i++) fResidualIndex.push_back(make_pair(make_pair(fMatchTrackIDs[i],fMatchClusterIDs[i]),i));
+  sort(fResidualIndex.begin(),fResidualIndex.end());
+  Int_t nPairs = 0;
+  for(Int_t i=0;i<nMatches;i++){
+    if(i+1 < nMatches && fResidualIndex[i+1].first == fResidualIndex[i].first) continue;
+    fResidualIndex[nPairs++] = fResidualIndex[i];
+  }
+  fResidualIndex.resize(nPairs);
+
+  fMatchResidual.resize(nMatches);
+  for(Int_t i=0;i<nMatches;i++){
+    vector<pair<pairInt,Int_t> >::const_iterator it = lower_bound(fResidualIndex.begin(),fResidualIndex.end(),make_pair(make_pair(fMatchTrackIDs[i],fMatchClusterIDs[i]),-1));
+    fMatchResidual[i] = it->second;
+  }
+
+  FillMatchTable(fMatchTrackKeys,fMatchClusterIDs,fTrackKeys,fTrackOffsets,fTrackToCluster);
+  FillMatchTable(fMatchClusterIDs,fMatchTrackKeys,fClusterKeys,fClusterOffsets,fClusterToTrack);
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::FillMatchTable(const vector<Int_t> &keys, const vector<Int_t> &partners, vector<Int_t> &tableKeys, vector<Int_t> &offsets, vector<pairInt> &entries){
+  // group the matches by key, within a key the matches stay in the order in which they were found
+  const Int_t nMatches = keys.size();
+  fMatchOrder.resize(nMatches);
+  for(Int_t i=0;i<nMatches;i++) fMatchOrder[i] = make_pair(keys[i],i);
+  sort(fMatchOrder.begin(),fMatchOrder.end());
+
+  tableKeys.clear();
+  offsets.clear();
+  entries.clear();
+  for(Int_t i=0;i<nMatches;i++){
+    if(tableKeys.empty() || tableKeys.back() != fMatchOrder[i].first){
+      tableKeys.push_back(fMatchOrder[i].first);
+      offsets.push_back(i);
+    }
+    Int_t match = fMatchOrder[i].second;
+    entries.push_back(make_pair(partners[match],fMatchResidual[match]));
+  }
+  offsets.push_back(nMatches);
+}
+
+//________________________________________________________________________
+Bool_t AliCaloTrackMatcher::FindMatches(const vector<Int_t> &tableKeys, const vector<Int_t> &offsets, Int_t key, Int_t &first, Int_t &last) const{
+  first = last = 0;
+  vector<Int_t>::const_iterator it = lower_bound(tableKeys.begin(),tableKeys.end(),key);
+  if(it == tableKeys.end() || *it != key) return kFALSE;
+  Int_t pos = it - tableKeys.begin();
+  first = offsets[pos];
+  last = offsets[pos+1];
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetTrackPosition(AliVEvent *event, Int_t trackID){
+  if(event->IsA()!=AliAODEvent::Class()) return trackID; // for ESD just take trackID
+
+  // for AOD, we have to look for position of track in the event, the first track with the given ID is taken
+  // the table is rebuilt if it was filled from another event
+  if(fTrackPositionsEvent != event){
+    fTrackIDToPosition.clear();
+    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
+      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
+      if(!currTrack) continue;
+      fTrackIDToPosition.push_back(make_pair(currTrack->GetID(),iTrack));
+    }
+    sort(fTrackIDToPosition.begin(),fTrackIDToPosition.end());
+    fTrackPositionsEvent = event;
+  }
+  vector<pairInt>::const_iterator it = lower_bound(fTrackIDToPosition.begin(),fTrackIDToPosition.end(),make_pair(trackID,-1));
+  if(it == fTrackIDToPosition.end() || it->first != trackID){
+    AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
+    return -1;
+  }
+  return it->second;
+}
+
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi){
 
@@ -748,32 +883,28 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  vector<pair<pairInt,Int_t> >::const_iterator it = lower_bound(fResidualIndex.begin(),fResidualIndex.end(),make_pair(make_pair(trackID,clusterID),-1));
+  if(it == fResidualIndex.end() || it->first != make_pair(trackID,clusterID)) return kFALSE;
 
-  pairFloat tempEtaPhi = fVectorDeltaEtaDeltaPhi.at(position-1);
-  dEta = tempEtaPhi.first;
-  dPhi = tempEtaPhi.second;
+  GetMatchingResidual(it->second,dEta,dPhi);
   return kTRUE;
 }
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
+  Int_t first = 0, last = 0;
+  FindMatches(fClusterKeys,fClusterOffsets,clusterID,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fClusterToTrack[i].first));
+    if(!tempTrack) continue;
+    GetMatchingResidual(fClusterToTrack[i].second,tempDEta,tempDPhi);
+    if(tempTrack->Charge()>0){
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
+    }else if(tempTrack->Charge()<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
     }
   }
 
@@ -783,24 +914,22 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-      }
-    }
+  Int_t first = 0, last = 0;
+  FindMatches(fClusterKeys,fClusterOffsets,clusterID,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fClusterToTrack[i].first));
+    if(!tempTrack) continue;
+    GetMatchingResidual(fClusterToTrack[i].second,tempDEta,tempDPhi);
+    Bool_t match_dEta = kFALSE;
+    Bool_t match_dPhi = kFALSE;
+    if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+    else match_dEta = kFALSE;
+
+    if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+    else match_dPhi = kFALSE;
+
+    if (match_dPhi && match_dEta )matched++;
   }
   return matched;
 }
@@ -808,16 +937,14 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
+  Int_t first = 0, last = 0;
+  FindMatches(fClusterKeys,fClusterOffsets,clusterID,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fClusterToTrack[i].first));
+    if(!tempTrack) continue;
+    GetMatchingResidual(fClusterToTrack[i].second,tempDEta,tempDPhi);
+    if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
   }
   return matched;
 }
@@ -825,34 +952,22 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
 
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
+  Int_t first = 0, last = 0;
+  FindMatches(fTrackKeys,fTrackOffsets,TrackPos,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    GetMatchingResidual(fTrackToCluster[i].second,tempDEta,tempDPhi);
+    if(tempTrack->Charge()>0){
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
+    }else if(tempTrack->Charge()<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
     }
   }
   return matched;
@@ -860,67 +975,43 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
+  Int_t first = 0, last = 0;
+  FindMatches(fTrackKeys,fTrackOffsets,TrackPos,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    GetMatchingResidual(fTrackToCluster[i].second,tempDEta,tempDPhi);
+    Bool_t match_dEta = kFALSE;
+    Bool_t match_dPhi = kFALSE;
+    if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+    else match_dEta = kFALSE;
 
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
+    if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+    else match_dPhi = kFALSE;
 
-        if (match_dPhi && match_dEta )matched++;
+    if (match_dPhi && match_dEta )matched++;
 
-      }
-    }
   }
   return matched;
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
+  Int_t first = 0, last = 0;
+  FindMatches(fTrackKeys,fTrackOffsets,TrackPos,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    GetMatchingResidual(fTrackToCluster[i].second,tempDEta,tempDPhi);
+    if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
   }
   return matched;
 }
@@ -928,21 +1019,19 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
-      }
+  Int_t first = 0, last = 0;
+  FindMatches(fClusterKeys,fClusterOffsets,clusterID,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fClusterToTrack[i].first));
+    if(!tempTrack) continue;
+    GetMatchingResidual(fClusterToTrack[i].second,tempDEta,tempDPhi);
+    if(tempTrack->Charge()>0){
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(fClusterToTrack[i].first);
+    }else if(tempTrack->Charge()<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(fClusterToTrack[i].first);
     }
   }
   return tempMatchedTracks;
@@ -951,25 +1040,23 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
+  Int_t first = 0, last = 0;
+  FindMatches(fClusterKeys,fClusterOffsets,clusterID,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fClusterToTrack[i].first));
+    if(!tempTrack) continue;
+    GetMatchingResidual(fClusterToTrack[i].second,tempDEta,tempDPhi);
+    Bool_t match_dEta = kFALSE;
+    Bool_t match_dPhi = kFALSE;
+    if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+    else match_dEta = kFALSE;
+
+    if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+    else match_dPhi = kFALSE;
+
+    if (match_dPhi && match_dEta )tempMatchedTracks.push_back(fClusterToTrack[i].first);
 
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
-
-      }
-    }
   }
   return tempMatchedTracks;
 }
@@ -977,50 +1064,36 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
-    }
+  Int_t first = 0, last = 0;
+  FindMatches(fClusterKeys,fClusterOffsets,clusterID,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(fClusterToTrack[i].first));
+    if(!tempTrack) continue;
+    GetMatchingResidual(fClusterToTrack[i].second,tempDEta,tempDPhi);
+    if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(fClusterToTrack[i].first);
   }
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
-      }
+  Int_t first = 0, last = 0;
+  FindMatches(fTrackKeys,fTrackOffsets,TrackPos,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    GetMatchingResidual(fTrackToCluster[i].second,tempDEta,tempDPhi);
+    if(tempTrack->Charge()>0){
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(fTrackToCluster[i].first);
+    }else if(tempTrack->Charge()<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(fTrackToCluster[i].first);
     }
   }
 
@@ -1029,66 +1102,42 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
-    }
+  Int_t first = 0, last = 0;
+  FindMatches(fTrackKeys,fTrackOffsets,TrackPos,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    GetMatchingResidual(fTrackToCluster[i].second,tempDEta,tempDPhi);
+    Bool_t match_dEta = kFALSE;
+    Bool_t match_dPhi = kFALSE;
+    if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
+    else match_dEta = kFALSE;
+
+    if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
+    else match_dPhi = kFALSE;
+
+    if (match_dPhi && match_dEta )tempMatchedClusters.push_back(fTrackToCluster[i].first);
   }
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID);
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
-    }
+  Int_t first = 0, last = 0;
+  FindMatches(fTrackKeys,fTrackOffsets,TrackPos,first,last);
+  for (Int_t i=first; i<last; i++){
+    Float_t tempDEta, tempDPhi;
+    GetMatchingResidual(fTrackToCluster[i].second,tempDEta,tempDPhi);
+    if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(fTrackToCluster[i].first);
   }
   return tempMatchedClusters;
 }
@@ -1538,11 +1587,10 @@ void AliCaloTrackMatcher::DebugMatching(){
     cout << "vector etaphi:" << endl;
     cout << fVectorDeltaEtaDeltaPhi.size() << endl;
     cout << "multimap" << endl;
-    mapT::iterator iter = fMap_TrID_ClID_ToIndex.begin();
-    for (iter = fMap_TrID_ClID_ToIndex.begin(); iter != fMap_TrID_ClID_ToIndex.end(); ++iter){
+    for (UInt_t i = 0; i < fResidualIndex.size(); i++){
       Float_t dEta, dPhi = 0;
-      if(!GetTrackClusterMatchingResidual(iter->first.first,iter->first.second,dEta,dPhi)) continue;
-      cout << "  [" << iter->first.first << "/" << iter->first.second << ", " << iter->second << "] - (" << dEta << "/" << dPhi << ")" << endl;
+      GetMatchingResidual(fResidualIndex[i].second,dEta,dPhi);
+      cout << "  [" << fResidualIndex[i].first.first << "/" << fResidualIndex[i].first.second << ", " << fResidualIndex[i].second << "] - (" << dEta << "/" << dPhi << ")" << endl;
     }
     cout << "mapTrackToCluster" << endl;
     AliESDEvent *esdev = dynamic_cast<AliESDEvent*>(fInputEvent);
@@ -1555,11 +1603,14 @@ void AliCaloTrackMatcher::DebugMatching(){
       cout << itr << " (" << tCharge << ") - " << GetNMatchedClusterIDsForTrack(fInputEvent,inTrack->GetID(),5,-5,0.2,-0.4) << "\t\t";
     }
     cout << endl;
-    multimap<Int_t,Int_t>::iterator it;
-    for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    for (UInt_t iKey = 0; iKey < fTrackKeys.size(); iKey++){
+      for (Int_t i = fTrackOffsets[iKey]; i < fTrackOffsets[iKey+1]; i++) cout << fTrackKeys[iKey] << " => " << fTrackToCluster[i].first << '\n';
+    }
     cout << "mapClusterToTrack" << endl;
-    Int_t tempClus = it->second;
-    for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    Int_t tempClus = fClusterKeys.back();
+    for (UInt_t iKey = 0; iKey < fClusterKeys.size(); iKey++){
+      for (Int_t i = fClusterOffsets[iKey]; i < fClusterOffsets[iKey+1]; i++) cout << fClusterKeys[iKey] << " => " << fClusterToTrack[i].first << '\n';
+    }
     vector<Int_t> tempTracks = GetMatchedTrackIDsForCluster(fInputEvent,tempClus, 5, -5, 0.2, -0.4);
     for(UInt_t iJ=0; iJ<tempTracks.size();iJ++){
       cout << tempClus << " - " << tempTracks.at(iJ) << endl;
@@ -4,6 +4,7 @@
 #include "AliAnalysisTaskSE.h"
 #include "AliEMCALGeometry.h"
 #include "AliPHOSGeometry.h"
+#include "AliVCluster.h"
 #include <vector>
 #include <map>
 #include <utility>
@@ -91,6 +92,11 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void Initialize(Int_t runNumber);
     void ProcessEvent(AliVEvent *event);
     void SetLogBinningYTH2(TH2* histoRebin);
+    void BuildMatchTables();
+    void FillMatchTable(const vector<Int_t> &keys, const vector<Int_t> &partners, vector<Int_t> &tableKeys, vector<Int_t> &offsets, vector<pairInt> &entries);
+    Bool_t FindMatches(const vector<Int_t> &tableKeys, const vector<Int_t> &offsets, Int_t key, Int_t &first, Int_t &last) const;
+    Int_t GetTrackPosition(AliVEvent *event, Int_t trackID);
+    void GetMatchingResidual(Int_t index, Float_t &dEta, Float_t &dPhi) const {dEta = fVectorDeltaEtaDeltaPhi[index].first; dPhi = fVectorDeltaEtaDeltaPhi[index].second;}
 
     // debug methods
     void DebugMatching();
@@ -117,13 +123,28 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     AliPHOSGeometry*      fGeomPHOS;               //! pointer to PHOS geometry
 
     TClonesArray*         fArrClusters;            //! array with clusters
+    vector<AliVCluster*>  fEventClusters;          //! clusters of the current event in the calorimeter of this matcher
+    vector<Float_t>       fEventClusterPos;        //! positions (x,y,z) of fEventClusters
 
-    multimap<Int_t,Int_t> fMapTrackToCluster;      //! connects a given track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fMapClusterToTrack;      //! connects a given cluster ID with all associated track IDs
-
-    Int_t                 fNEntries;               //! number of current TrackID/ClusterID -> Eta/Phi connections
+    // matches of the current event, index i of the vectors corresponds to fVectorDeltaEtaDeltaPhi[i]
     vector<pairFloat>     fVectorDeltaEtaDeltaPhi; //! vector of all matching residuals for a specific TrackID/ClusterID
-    mapT                  fMap_TrID_ClID_ToIndex;  //! map tuple of (trackID,clusterID) to index in vector fVectorDeltaEtaDeltaPhi
+    vector<Int_t>         fMatchTrackKeys;         //! track key of the match: position in event (AOD) or track ID (ESD)
+    vector<Int_t>         fMatchTrackIDs;          //! track ID of the match
+    vector<Int_t>         fMatchClusterIDs;        //! cluster ID of the match
+    vector<Int_t>         fMatchResidual;          //! index of the residual returned for (track ID, cluster ID) of the match
+    vector<pairInt>       fMatchOrder;             //! (key, match index) buffer for sorting
+
+    // flat tables built at the end of ProcessEvent: sorted keys, offsets (size nKeys+1) and (partner, residual index) entries
+    vector<Int_t>         fTrackKeys;              //! sorted track keys with at least one matched cluster
+    vector<Int_t>         fTrackOffsets;           //! entries of fTrackKeys[i] are [fTrackOffsets[i],fTrackOffsets[i+1]) in fTrackToCluster
+    vector<pairInt>       fTrackToCluster;         //! (cluster ID, residual index) per matched track, in order of matching
+    vector<Int_t>         fClusterKeys;            //! sorted cluster IDs with at least one matched track
+    vector<Int_t>         fClusterOffsets;         //! entries of fClusterKeys[i] are [fClusterOffsets[i],fClusterOffsets[i+1]) in fClusterToTrack
+    vector<pairInt>       fClusterToTrack;         //! (track key, residual index) per matched cluster, in order of matching
+    vector<pair<pairInt,Int_t> > fResidualIndex;   //! sorted (trackID,clusterID) -> index in fVectorDeltaEtaDeltaPhi
+
+    vector<pairInt>       fTrackIDToPosition;      //! sorted (track ID, position in event) for AOD, filled on first request per event
+    AliVEvent*            fTrackPositionsEvent;    //! event fTrackIDToPosition was filled from, 0x0 if not filled for the current event
 
     // for cluster <-> V0-track matching (running with different mass hypthesis)
     multimap<Int_t,Int_t> fSecMapTrackToCluster;      //! connects a given secondary track ID with all associated cluster IDs
@@ -142,7 +163,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     Bool_t                fDoLightOutput;          // switch for running light output, kFALSE -> normal mode, kTRUE -> light mode
 
     Double_t              fMassHypothesis;          // mass used for track propagation to calorimeter surface
-    ClassDef(AliCaloTrackMatcher,9)
+    ClassDef(AliCaloTrackMatcher,10)
 };
 
 #endif
@@ -69,12 +69,18 @@
 #include "AliAODv0.h"
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
+#include "AliAnalysisManager.h"
 #include <cstring>
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
 /// \endcond
 
+const AliVEvent* AliAnalysisVertexingHF::fgRefillEvent = 0x0;
+TTree*           AliAnalysisVertexingHF::fgRefillTree = 0x0;
+Long64_t         AliAnalysisVertexingHF::fgRefillEntry = -1;
+TExMap           AliAnalysisVertexingHF::fgRefillFailed;
+
 //----------------------------------------------------------------------------
 AliAnalysisVertexingHF::AliAnalysisVertexingHF():
 fInputAOD(kFALSE),
@@ -139,6 +145,10 @@ fFindVertexForDstar(kTRUE),
 fFindVertexForCascades(kTRUE),
 fV0TypeForCascadeVertex(0),
 fMassCutBeforeVertexing(kFALSE),
+fPairDCACacheMaxTracks(0),
+fPairDCAIndex(),
+fPairDCACache(),
+fNPairDCA(0),
 fMassCalc2(0),
 fMassCalc3(0),
 fMassCalc4(0),
@@ -238,6 +248,10 @@ fFindVertexForDstar(source.fFindVertexForDstar),
 fFindVertexForCascades(source.fFindVertexForCascades),
 fV0TypeForCascadeVertex(source.fV0TypeForCascadeVertex),
 fMassCutBeforeVertexing(source.fMassCutBeforeVertexing),
+fPairDCACacheMaxTracks(source.fPairDCACacheMaxTracks),
+fPairDCAIndex(),
+fPairDCACache(),
+fNPairDCA(0),
 fMassCalc2(source.fMassCalc2),
 fMassCalc3(source.fMassCalc3),
 fMassCalc4(source.fMassCalc4),
@@ -336,6 +350,7 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fFindVertexForCascades = source.fFindVertexForCascades;
   fV0TypeForCascadeVertex = source.fV0TypeForCascadeVertex;
   fMassCutBeforeVertexing = source.fMassCutBeforeVertexing;
+  fPairDCACacheMaxTracks = source.fPairDCACacheMaxTracks;
   fMassCalc2 = source.fMassCalc2;
   fMassCalc3 = source.fMassCalc3;
   fMassCalc4 = source.fMassCalc4;
@@ -629,6 +644,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // the same track pairs are tested in the 2, 3 and 4 prong loops
+  InitPairDCACache(nSeleTrks,seleFlags);
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -876,7 +894,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       negtrack1->GetPxPyPz(momneg1);
 
       // DCA between the two tracks
-      dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+      dcap1n1 = GetPairDCA(postrack1,iTrkP1,negtrack1,iTrkN1);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
 
       // Vertexing
@@ -1139,9 +1157,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
-	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+	dcap2n1 = GetPairDCA(postrack2,iTrkP2,negtrack1,iTrkN1);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	dcap1p2 = GetPairDCA(postrack2,iTrkP2,postrack1,iTrkP1);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
 	// check invariant mass cuts for D+,Ds,Lc
@@ -1277,9 +1295,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-            dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+            dcap2n2 = GetPairDCA(postrack2,iTrkP2,negtrack2,iTrkN2);
             if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
 
 
@@ -1410,9 +1428,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2);
 	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcan1n2 = GetPairDCA(negtrack1,iTrkN1,negtrack2,iTrkN2);
 	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
 
 	threeTrackArray->AddAt(negtrack1,0);
@@ -1699,69 +1717,62 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF3P
   // method to retrieve daughters from trackID and reconstruct secondary vertex
   // save the TRefs to the candidate AliAODRecoDecayHF3Prong rd
   // and fill on-the-fly the data member of rd
+  // the temporary tracks and primary vertex are kept on the stack
   if(rd->GetIsFilled()!=0)return kTRUE;//if 0: reduced dAOD. skip if rd is already filled (1: standard dAOD, 2 already refilled)
+  if(IsRefillFailed(event,rd)) return kFALSE;//refill already tried in this event by another instance
   if(!fAODMap)MapAODtracks(event);//fill the AOD index map if it is not yet done
-  TObjArray *threeTrackArray   = new TObjArray(3);
 
   AliAODTrack *track1 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(0)]);//retrieve daughter from the trackID through the AOD index map
   if(!track1)return kFALSE;
   AliAODTrack *track2 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(1)]);
   if(!track2)return kFALSE;
-  AliESDtrack *postrack1 = 0;
-  AliESDtrack *negtrack1 = 0;
-  postrack1 = new AliESDtrack(track1);
-  negtrack1 = new AliESDtrack(track2);
+  AliAODTrack *track3 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(2)]);
+  if(!track3)return kFALSE;
+  AliESDtrack postrack1(track1);
+  AliESDtrack negtrack1(track2);
+  AliESDtrack esdt3(track3);
 
   // DCA between the two tracks
   Double_t xdummy, ydummy;
   fBzkG = (Double_t)event->GetMagneticField();
-  Double_t dca12 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+  Double_t dca12 = postrack1.GetDCA(&negtrack1,fBzkG,xdummy,ydummy);
 
   const AliVVertex *vprimary = event->GetPrimaryVertex();
   Double_t pos[3];
   Double_t cov[6];
   vprimary->GetXYZ(pos);
   vprimary->GetCovarianceMatrix(cov);
-  fV1 = new AliESDVertex(pos,cov,100.,100,vprimary->GetName());
+  AliESDVertex v1(pos,cov,100.,100,vprimary->GetName());
+  fV1 = &v1;
   fV1->GetCovMatrix(cov);
   if(!fVertexerTracks)fVertexerTracks=new AliVertexerTracks(fBzkG);
 
-  AliAODTrack *track3 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(2)]);
-  if(!track3)return kFALSE;
-  AliESDtrack *esdt3 = new AliESDtrack(track3);
-
   Double_t dca2;
   Double_t dca3;
-  threeTrackArray->AddAt(postrack1,0);
-  threeTrackArray->AddAt(negtrack1,1);
-  threeTrackArray->AddAt(esdt3,2);
-  dca2 = esdt3->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
-  dca3 = esdt3->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+  TObjArray threeTrackArray(3);
+  threeTrackArray.AddAt(&postrack1,0);
+  threeTrackArray.AddAt(&negtrack1,1);
+  threeTrackArray.AddAt(&esdt3,2);
+  dca2 = esdt3.GetDCA(&negtrack1,fBzkG,xdummy,ydummy);
+  dca3 = esdt3.GetDCA(&postrack1,fBzkG,xdummy,ydummy);
   Double_t dispersion;
 
-  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray, dispersion);
+  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(&threeTrackArray, dispersion);
   if (!secVert3PrAOD) {
-    threeTrackArray->Clear();
-    threeTrackArray->Delete(); delete threeTrackArray;
-    delete fV1; fV1=0;
-    delete postrack1; postrack1=NULL;
-    delete negtrack1; negtrack1=NULL;
-    delete esdt3; esdt3=NULL;
+    threeTrackArray.Clear();
+    fV1=0;
+    SetRefillFailed(event,rd);
     return kFALSE;
   }
 
   rd->SetNProngs();
   Double_t vtxRec=rd->GetDist12toPrim();
   Double_t vertexp2n1=rd->GetDist23toPrim();
-  rd= Make3Prong(threeTrackArray, event, secVert3PrAOD,dispersion, vtxRec, vertexp2n1, dca12, dca2, dca3, rd);
+  rd= Make3Prong(&threeTrackArray, event, secVert3PrAOD,dispersion, vtxRec, vertexp2n1, dca12, dca2, dca3, rd);
   rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
   rd->SetIsFilled(2);
-  threeTrackArray->Clear();
-  threeTrackArray->Delete(); delete threeTrackArray;
-  delete fV1; fV1=0;
-  delete postrack1; postrack1=NULL;
-  delete negtrack1; negtrack1=NULL;
-  delete esdt3; esdt3=NULL;
+  threeTrackArray.Clear();
+  fV1=0;
   return kTRUE;
 }
 //___________________________
@@ -1769,66 +1780,97 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF2P
   // method to retrieve daughters from trackID and reconstruct secondary vertex
   // save the TRefs to the candidate AliAODRecoDecayHF2Prong rd
   // and fill on-the-fly the data member of rd
+  // the temporary tracks and primary vertex are kept on the stack
   if(rd->GetIsFilled()!=0)return kTRUE;//if 0: reduced dAOD. skip if rd is already filled (1:standard dAOD, 2 already refilled)
+  if(IsRefillFailed(event,rd)) return kFALSE;//refill already tried in this event by another instance
   if(!fAODMap)MapAODtracks(event);//fill the AOD index map if it is not yet done
 
   Double_t dispersion;
-  TObjArray *twoTrackArray1    = new TObjArray(2);
 
   AliAODTrack *track1 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(0)]);//retrieve daughter from the trackID through the AOD index map
   if(!track1)return kFALSE;
   AliAODTrack *track2 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(1)]);
   if(!track2)return kFALSE;
 
-  AliESDtrack *esdt1 = 0;
-  AliESDtrack *esdt2 = 0;
-  esdt1 = new AliESDtrack(track1);
-  esdt2 = new AliESDtrack(track2);
+  AliESDtrack esdt1(track1);
+  AliESDtrack esdt2(track2);
 
-  twoTrackArray1->AddAt(esdt1,0);
-  twoTrackArray1->AddAt(esdt2,1);
+  TObjArray twoTrackArray1(2);
+  twoTrackArray1.AddAt(&esdt1,0);
+  twoTrackArray1.AddAt(&esdt2,1);
   // DCA between the two tracks
   Double_t xdummy, ydummy;
   fBzkG = (Double_t)event->GetMagneticField();
-  Double_t dca12 = esdt1->GetDCA(esdt2,fBzkG,xdummy,ydummy);
+  Double_t dca12 = esdt1.GetDCA(&esdt2,fBzkG,xdummy,ydummy);
   const AliVVertex *vprimary = event->GetPrimaryVertex();
   Double_t pos[3];
   Double_t cov[6];
   vprimary->GetXYZ(pos);
   vprimary->GetCovarianceMatrix(cov);
-  fV1 = new AliESDVertex(pos,cov,100.,100,vprimary->GetName());
+  AliESDVertex v1(pos,cov,100.,100,vprimary->GetName());
+  fV1 = &v1;
   fV1->GetCovMatrix(cov);
   if(!fVertexerTracks)fVertexerTracks=new AliVertexerTracks(fBzkG);
 
 
-  AliAODVertex *vtxRec = ReconstructSecondaryVertex(twoTrackArray1, dispersion);
+  AliAODVertex *vtxRec = ReconstructSecondaryVertex(&twoTrackArray1, dispersion);
   if(!vtxRec) {
-    twoTrackArray1->Clear();
-    twoTrackArray1->Delete();  delete twoTrackArray1;
-    delete fV1; fV1=0;
-    delete esdt1; esdt1=NULL;
-    delete esdt2; esdt2=NULL;
+    twoTrackArray1.Clear();
+    fV1=0;
+    SetRefillFailed(event,rd);
     return kFALSE;     }
   Bool_t okD0=kFALSE;
   Bool_t okJPSI=kFALSE;
   Bool_t okD0FromDstar=kFALSE;
   Bool_t refill =kTRUE;
   rd->SetNProngs();
-  rd= Make2Prong(twoTrackArray1, event, vtxRec, dca12, okD0, okJPSI, okD0FromDstar, kFALSE, refill, rd);
+  rd= Make2Prong(&twoTrackArray1, event, vtxRec, dca12, okD0, okJPSI, okD0FromDstar, kFALSE, refill, rd);
   rd->SetPrimaryVtxRef((AliAODVertex*)event->GetPrimaryVertex());
   rd->SetIsFilled(2);
-  delete fV1; fV1=0;
-  twoTrackArray1->Clear();
-  twoTrackArray1->Delete();  delete twoTrackArray1;
-  delete esdt1; esdt1=NULL;
-  delete esdt2; esdt2=NULL;
+  fV1=0;
+  twoTrackArray1.Clear();
+  return kTRUE;
+}
+//----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::UpdateRefillEvent(const AliVEvent *event){
+  /// Identify the current event for the bookkeeping of the failed refills, which is shared by
+  /// all the instances of the train. Returns kFALSE if the event cannot be identified.
+
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  TTree *tree = mgr ? mgr->GetTree() : 0x0;
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if(entry<0) return kFALSE;
+  if(fgRefillEvent!=event || fgRefillTree!=tree || fgRefillEntry!=entry){
+    fgRefillEvent = event;
+    fgRefillTree = tree;
+    fgRefillEntry = entry;
+    fgRefillFailed.Delete();
+  }
   return kTRUE;
 }
 //----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::IsRefillFailed(const AliVEvent *event,const AliAODRecoDecayHF *rd,UInt_t mode){
+  /// True if the refill of the candidate with the given mode already failed in the current event.
+  /// The map stores per candidate one bit per refill mode, since the outcome depends on the
+  /// arguments of the Fill method (e.g. DStar and recoSecVtx for the cascades)
+
+  if(!UpdateRefillEvent(event)) return kFALSE;
+  return (fgRefillFailed.GetValue((Long64_t)rd) & (1ll<<mode))!=0;
+}
+//----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::SetRefillFailed(const AliVEvent *event,const AliAODRecoDecayHF *rd,UInt_t mode){
+  /// Remember that the refill of the candidate with the given mode failed in the current event
+
+  if(!UpdateRefillEvent(event)) return;
+  fgRefillFailed((Long64_t)rd) |= (1ll<<mode);
+}
+//----------------------------------------------------------------------------
 Bool_t AliAnalysisVertexingHF::FillRecoCasc(AliVEvent *event,AliAODRecoCascadeHF *rCasc, Bool_t DStar, Bool_t recoSecVtx){
   // method to retrieve daughters from trackID
   // and fill on-the-fly the data member of rCasc and their AliAODRecoDecayHF2Prong daughters
   if(rCasc->GetIsFilled()!=0) return kTRUE;//if 0: reduced dAOD. skip if rd is already filled (1: standard dAOD, 2: already refilled)
+  const UInt_t refillMode = (DStar ? 2 : 0) + (recoSecVtx ? 1 : 0);
+  if(IsRefillFailed(event,rCasc,refillMode)) return kFALSE;//refill already tried in this event by another instance
   if(!fAODMap)MapAODtracks(event);//fill the AOD index map if it is not yet done
   TObjArray *twoTrackArrayCasc    = new TObjArray(2);
 
@@ -1894,6 +1936,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCasc(AliVEvent *event,AliAODRecoCascadeHF
     if(!DStar){
     v0=NULL;
     }
+    SetRefillFailed(event,rCasc,refillMode);
     return kFALSE;
   }
   vtxCasc->SetParent(rCasc);
@@ -1922,6 +1965,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCasc(AliVEvent *event,AliAODRecoCascadeHF
     delete esdB; esdB=NULL;
     delete trackV0; trackV0=NULL;
     if(!DStar)v0=NULL;
+    SetRefillFailed(event,rCasc,refillMode);
     return kFALSE;
   }
   Double_t d0z0[2],covd0z0[3];
@@ -3774,6 +3818,40 @@ void AliAnalysisVertexingHF::SetParametersAtVertex(AliESDtrack* esdt, const AliE
   return;
 }
 //-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::InitPairDCACache(Int_t nSeleTrks,const UChar_t *seleFlags){
+  /// Prepare the memoization of the DCAs between the displaced tracks of the event.
+  /// The cache is not used if it is switched off or if there are too many displaced tracks
+
+  fNPairDCA=0;
+  if(fPairDCACacheMaxTracks<=0) return;
+  fPairDCAIndex.assign(nSeleTrks,-1);
+  Int_t nDispl=0;
+  for(Int_t i=0; i<nSeleTrks; i++) {
+    if(TESTBIT(seleFlags[i],kBitDispl)) fPairDCAIndex[i]=nDispl++;
+  }
+  if(nDispl>fPairDCACacheMaxTracks) {
+    AliDebug(2,Form(" %d displaced tracks, pair DCA cache not used",nDispl));
+    return;
+  }
+  fNPairDCA=nDispl;
+  fPairDCACache.assign(nDispl*nDispl,-1.);
+  return;
+}
+//-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::GetPairDCA(const AliESDtrack *trk1,Int_t iTrk1,const AliESDtrack *trk2,Int_t iTrk2){
+  /// DCA between two selected tracks, which must have their parameters at the primary vertex.
+  /// The result is memoized for the ordered pair, so it is identical to trk1->GetDCA(trk2)
+
+  Double_t xdummy,ydummy;
+  if(fNPairDCA<=0) return trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  Int_t k1=fPairDCAIndex[iTrk1];
+  Int_t k2=fPairDCAIndex[iTrk2];
+  if(k1<0 || k2<0) return trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  Double_t &dca=fPairDCACache[k1*fNPairDCA+k2];
+  if(dca<0.) dca=trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  return dca;
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::SetMasses(){
   /// Set the hadron mass values from TDatabasePDG
 
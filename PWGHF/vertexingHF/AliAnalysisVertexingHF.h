@@ -13,12 +13,16 @@
 /// \author Contact: andrea.dainese@pd.infn.it
 //-------------------------------------------------------------------------
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TList.h>
+#include <TExMap.h>
 
 #include "AliAnalysisFilter.h"
 #include "AliESDtrackCuts.h"
 
+class TTree;
 class AliPIDResponse;
 class AliESDVertex;
 class AliAODRecoDecay;
@@ -179,6 +183,8 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  /// memoize the track-pair DCAs within the event, for up to maxTracks displaced tracks (0 = off)
+  void SetPairDCACache(Int_t maxTracks=2000) { fPairDCACacheMaxTracks=maxTracks; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -328,6 +334,10 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t fFindVertexForCascades;  /// reconstruct a secondary vertex or assume it's from the primary vertex
   Int_t  fV0TypeForCascadeVertex;  /// Select which V0 type we want to use for the cascas
   Bool_t fMassCutBeforeVertexing; /// to go faster in PbPb
+  Int_t  fPairDCACacheMaxTracks; /// max number of displaced tracks for the pair DCA cache (0 = off)
+  std::vector<Int_t>    fPairDCAIndex; //!<! index of the selected tracks in the pair DCA cache (-1 if not cached)
+  std::vector<Double_t> fPairDCACache; //!<! DCAs of the ordered track pairs (-1 if not yet computed)
+  Int_t  fNPairDCA;                    //!<! number of tracks in the pair DCA cache
   // dummies for invariant mass calculation
   AliAODRecoDecay *fMassCalc2; /// for 2 prong
   AliAODRecoDecay *fMassCalc3; /// for 3 prong
@@ -420,6 +430,16 @@ class AliAnalysisVertexingHF : public TNamed {
 				   Int_t &nSeleTrks,
 				   UChar_t *seleFlags,Int_t *evtNumber);
   void SetParametersAtVertex(AliESDtrack* esdt, const AliExternalTrackParam* extpar) const;
+  void InitPairDCACache(Int_t nSeleTrks,const UChar_t *seleFlags);
+
+  static Bool_t UpdateRefillEvent(const AliVEvent *event);
+  static Bool_t IsRefillFailed(const AliVEvent *event,const AliAODRecoDecayHF *rd,UInt_t mode=0);
+  static void   SetRefillFailed(const AliVEvent *event,const AliAODRecoDecayHF *rd,UInt_t mode=0);
+  static const AliVEvent *fgRefillEvent; //!<! event of the failed refills
+  static TTree    *fgRefillTree;         //!<! tree of the failed refills
+  static Long64_t  fgRefillEntry;        //!<! entry of the failed refills
+  static TExMap    fgRefillFailed;       //!<! refill modes (bits) failed per candidate in the current event, shared by the instances of the train
+  Double_t GetPairDCA(const AliESDtrack *trk1,Int_t iTrk1,const AliESDtrack *trk2,Int_t iTrk2);
 
   Bool_t SingleTrkCuts(AliESDtrack *trk,Float_t centralityperc, Bool_t &okDisplaced,Bool_t &okSoftPi, Bool_t &ok3prong, Bool_t &okBachelor) const;
 
@@ -429,7 +449,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,30);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,31);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
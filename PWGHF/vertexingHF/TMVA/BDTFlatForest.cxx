@@ -0,0 +1,307 @@
+#include "BDTFlatForest.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "BDTNode.h"
+
+namespace {
+  // value of attribute "name" in the xml tag (empty if not found)
+  std::string GetAttribute( const std::string& tag, const std::string& name )
+  {
+    std::string key = " " + name + "=\"";
+    size_t start = tag.find(key);
+    if (start == std::string::npos) return "";
+    start += key.size();
+    size_t end = tag.find('"', start);
+    if (end == std::string::npos) return "";
+    return tag.substr(start, end - start);
+  }
+
+  // text of <Option name="name" ...>text</Option> (empty if not found)
+  std::string GetOption( const std::string& xml, const std::string& name )
+  {
+    size_t start = xml.find("<Option name=\"" + name + "\"");
+    if (start == std::string::npos) return "";
+    start = xml.find('>', start);
+    size_t end = xml.find('<', start);
+    if (start == std::string::npos || end == std::string::npos) return "";
+    return xml.substr(start + 1, end - start - 1);
+  }
+}
+
+//_______________________________________________________________________
+BDTFlatForest::BDTFlatForest()
+  : IClassifierReader(),
+    fLeafType(kYesNoLeaf),
+    fInputVars(),
+    fNodes(),
+    fTreeRoot(),
+    fTreeWeight(),
+    fNorm(0)
+{
+}
+
+//_______________________________________________________________________
+BDTFlatForest::BDTFlatForest( const std::string& weightsFile )
+  : IClassifierReader(),
+    fLeafType(kYesNoLeaf),
+    fInputVars(),
+    fNodes(),
+    fTreeRoot(),
+    fTreeWeight(),
+    fNorm(0)
+{
+  LoadWeightsXML(weightsFile);
+}
+
+//_______________________________________________________________________
+void BDTFlatForest::Clear()
+{
+  fNodes.clear();
+  fTreeRoot.clear();
+  fTreeWeight.clear();
+  fNorm = 0;
+}
+
+//_______________________________________________________________________
+int BDTFlatForest::AddNode( int var, double value )
+{
+  Node node;
+  node.fValue = value;
+  node.fVar = var;
+  node.fChildAbove = -1;
+  node.fChildBelow = -1;
+  fNodes.push_back(node);
+  return fNodes.size() - 1;
+}
+
+//_______________________________________________________________________
+void BDTFlatForest::SetChildren( int node, int left, int right, bool cutType )
+{
+  // cutType true: event goes right if the variable is above the cut
+  fNodes[node].fChildAbove = cutType ? right : left;
+  fNodes[node].fChildBelow = cutType ? left : right;
+}
+
+//_______________________________________________________________________
+int BDTFlatForest::FlattenNode( BDTNode* node )
+{
+  if (node->GetNodeType() != 0) {
+    double value = node->GetNodeType();
+    if (fLeafType == kPurityLeaf) value = node->GetPurity();
+    else if (fLeafType == kGradResponse) value = node->GetResponse();
+    return AddNode(-1, value);
+  }
+  int index = AddNode(node->GetSelector(), node->GetCutValue());
+  int left = FlattenNode(node->GetLeft());
+  int right = FlattenNode(node->GetRight());
+  SetChildren(index, left, right, node->GetCutType());
+  return index;
+}
+
+//_______________________________________________________________________
+void BDTFlatForest::AddTree( BDTNode* root, double boostWeight )
+{
+  if (!root) return;
+  // gradient boosted trees sum the responses without weights
+  if (fLeafType == kGradResponse) boostWeight = 1;
+  fTreeRoot.push_back(FlattenNode(root));
+  fTreeWeight.push_back(boostWeight);
+  fNorm += boostWeight;
+}
+
+//_______________________________________________________________________
+void BDTFlatForest::AddForest( const std::vector<BDTNode*>& forest, const std::vector<double>& boostWeights )
+{
+  if (forest.size() != boostWeights.size()) {
+    std::cout << "Problem in class \"BDTFlatForest\": number of trees and boost weights differ" << std::endl;
+    fStatusIsClean = false;
+    return;
+  }
+  for (size_t itree = 0; itree < forest.size(); itree++) AddTree(forest[itree], boostWeights[itree]);
+}
+
+//_______________________________________________________________________
+bool BDTFlatForest::LoadWeightsXML( const std::string& weightsFile )
+{
+  std::ifstream file(weightsFile.c_str());
+  if (!file.good()) {
+    std::cout << "Problem in class \"BDTFlatForest\": cannot open " << weightsFile << std::endl;
+    fStatusIsClean = false;
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string xml = buffer.str();
+
+  // only untransformed input variables are supported
+  size_t transf = xml.find("<Transformations");
+  if (transf != std::string::npos && GetAttribute(xml.substr(transf, xml.find('>', transf) - transf), "NTransformations") != "0") {
+    std::cout << "Problem in class \"BDTFlatForest\": variable transformations are not supported" << std::endl;
+    fStatusIsClean = false;
+    return false;
+  }
+  if (GetOption(xml, "BoostType") == "Grad") fLeafType = kGradResponse;
+  else if (GetOption(xml, "UseYesNoLeaf") == "False") fLeafType = kPurityLeaf;
+  else fLeafType = kYesNoLeaf;
+
+  fInputVars.clear();
+  size_t pos = xml.find("<Variables");
+  size_t end = xml.find("</Variables>");
+  while (pos != std::string::npos && (pos = xml.find("<Variable ", pos)) != std::string::npos && pos < end) {
+    size_t close = xml.find('>', pos);
+    fInputVars.push_back(GetAttribute(xml.substr(pos, close - pos), "Expression"));
+    pos = close;
+  }
+
+  Clear();
+  std::vector<int> open; // internal nodes whose children are being read
+  std::vector<int> left, right;
+  std::vector<bool> cutType;
+  pos = xml.find("<BinaryTree");
+  while (pos != std::string::npos) {
+    size_t close = xml.find('>', pos);
+    if (close == std::string::npos) break;
+    const std::string tag = xml.substr(pos, close - pos + 1);
+    if (tag.compare(0, 11, "<BinaryTree") == 0) {
+      double weight = atof(GetAttribute(tag, "boostWeight").c_str());
+      if (fLeafType == kGradResponse) weight = 1;
+      fTreeRoot.push_back(fNodes.size());
+      fTreeWeight.push_back(weight);
+      fNorm += weight;
+      open.clear();
+    } else if (tag.compare(0, 5, "<Node") == 0) {
+      int var = atoi(GetAttribute(tag, "IVar").c_str());
+      int nType = atoi(GetAttribute(tag, "nType").c_str());
+      double value = atof(GetAttribute(tag, "Cut").c_str());
+      if (nType != 0) {
+        var = -1;
+        value = nType;
+        if (fLeafType == kPurityLeaf) value = atof(GetAttribute(tag, "purity").c_str());
+        else if (fLeafType == kGradResponse) value = atof(GetAttribute(tag, "res").c_str());
+      }
+      int index = AddNode(var, value);
+      left.push_back(-1);
+      right.push_back(-1);
+      cutType.push_back(atoi(GetAttribute(tag, "cType").c_str()) != 0);
+      if (!open.empty()) {
+        if (GetAttribute(tag, "pos") == "l") left[open.back()] = index;
+        else right[open.back()] = index;
+      }
+      if (tag[tag.size() - 2] != '/') open.push_back(index);
+    } else if (tag.compare(0, 7, "</Node>") == 0) {
+      if (!open.empty()) open.pop_back();
+    } else if (tag.compare(0, 10, "</Weights>") == 0) {
+      break;
+    }
+    pos = xml.find('<', close);
+  }
+
+  for (size_t inode = 0; inode < fNodes.size(); inode++) {
+    if (fNodes[inode].fVar < 0) continue;
+    if (left[inode] < 0 || right[inode] < 0) {
+      std::cout << "Problem in class \"BDTFlatForest\": incomplete node " << inode << " in " << weightsFile << std::endl;
+      fStatusIsClean = false;
+      return false;
+    }
+    SetChildren(inode, left[inode], right[inode], cutType[inode]);
+  }
+  if (fTreeRoot.empty()) {
+    std::cout << "Problem in class \"BDTFlatForest\": no trees found in " << weightsFile << std::endl;
+    fStatusIsClean = false;
+    return false;
+  }
+  return true;
+}
+
+//_______________________________________________________________________
+bool BDTFlatForest::CheckInputVariables( const std::vector<std::string>& theInputVars )
+{
+  if (theInputVars.size() != fInputVars.size()) {
+    std::cout << "Problem in class \"BDTFlatForest\": mismatch in number of input values: "
+              << theInputVars.size() << " != " << fInputVars.size() << std::endl;
+    fStatusIsClean = false;
+    return false;
+  }
+  for (size_t ivar = 0; ivar < theInputVars.size(); ivar++) {
+    if (theInputVars[ivar] != fInputVars[ivar]) {
+      std::cout << "Problem in class \"BDTFlatForest\": mismatch in input variable names" << std::endl
+                << " for variable [" << ivar << "]: " << theInputVars[ivar].c_str() << " != " << fInputVars[ivar] << std::endl;
+      fStatusIsClean = false;
+      return false;
+    }
+  }
+  return true;
+}
+
+//_______________________________________________________________________
+double BDTFlatForest::Finalise( double sum ) const
+{
+  if (fLeafType == kGradResponse) return 2.0/(1.0+std::exp(-2.0*sum))-1.0;
+  return sum / fNorm;
+}
+
+//_______________________________________________________________________
+double BDTFlatForest::GetMvaValue( const double* inputValues ) const
+{
+  if (!IsStatusClean()) {
+    std::cout << "Problem in class \"BDTFlatForest\": cannot return classifier response"
+              << " because status is dirty" << std::endl;
+    return 0;
+  }
+  double sum = 0;
+  for (size_t itree = 0; itree < fTreeRoot.size(); itree++) {
+    const Node* node = &fNodes[fTreeRoot[itree]];
+    while (node->fVar >= 0) {
+      node = &fNodes[(inputValues[node->fVar] > node->fValue) ? node->fChildAbove : node->fChildBelow];
+    }
+    sum += fTreeWeight[itree] * node->fValue;
+  }
+  return Finalise(sum);
+}
+
+//_______________________________________________________________________
+double BDTFlatForest::GetMvaValue( const std::vector<double>& inputValues ) const
+{
+  return GetMvaValue(&inputValues[0]);
+}
+
+//_______________________________________________________________________
+void BDTFlatForest::GetMvaValues( const double* inputValues, int nCand, int nVar, double* mvaValues ) const
+{
+  // trees are evaluated one after the other on blocks of candidates, so the
+  // nodes of one tree stay in cache and the descent of the candidates in a
+  // block is independent (no data dependent branches across candidates)
+  if (!IsStatusClean()) {
+    for (int icand = 0; icand < nCand; icand++) mvaValues[icand] = 0;
+    return;
+  }
+  const int kBlock = 64;
+  const Node* node[kBlock];
+  const Node* nodes = &fNodes[0];
+  double sum[kBlock];
+  for (int first = 0; first < nCand; first += kBlock) {
+    const int n = (nCand - first < kBlock) ? nCand - first : kBlock;
+    const double* block = inputValues + (size_t)first * nVar;
+    for (int i = 0; i < n; i++) sum[i] = 0;
+    for (size_t itree = 0; itree < fTreeRoot.size(); itree++) {
+      for (int i = 0; i < n; i++) node[i] = nodes + fTreeRoot[itree];
+      bool active = true;
+      while (active) {
+        active = false;
+        for (int i = 0; i < n; i++) {
+          const int var = node[i]->fVar;
+          if (var < 0) continue;
+          node[i] = nodes + ((block[i * nVar + var] > node[i]->fValue) ? node[i]->fChildAbove : node[i]->fChildBelow);
+          active = true;
+        }
+      }
+      const double weight = fTreeWeight[itree];
+      for (int i = 0; i < n; i++) sum[i] += weight * node[i]->fValue;
+    }
+    for (int i = 0; i < n; i++) mvaValues[first + i] = Finalise(sum[i]);
+  }
+}
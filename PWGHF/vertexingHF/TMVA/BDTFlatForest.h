@@ -0,0 +1,76 @@
+#ifndef BDTFlatForest__def
+#define BDTFlatForest__def
+
+// Class: BDTFlatForest
+// Evaluator for TMVA BDT forests stored as contiguous node arrays
+// (variable index, cut value and child indices) instead of trees of
+// heap allocated BDTNode objects. The forest is filled either from
+// the nodes of a generated ReadBDT class or directly from the TMVA
+// weights.xml file, so the generated sources are not needed anymore.
+//
+// Each internal node is stored with the child reached when the
+// variable is above the cut and the one reached otherwise (the cut
+// type is folded in at filling), leaves keep the variable index -1
+// and their value in place of the cut.
+
+#include <vector>
+#include <string>
+#include "IClassifierReader.h"
+
+class BDTNode;
+
+class BDTFlatForest : public IClassifierReader
+{
+ public:
+  // leaf value used in the sum over the trees
+  enum ELeafType { kYesNoLeaf = 0, kPurityLeaf = 1, kGradResponse = 2 };
+
+  BDTFlatForest();
+  // build the forest from a TMVA weights.xml file
+  BDTFlatForest( const std::string& weightsFile );
+  virtual ~BDTFlatForest() {}
+
+  // fill from the weights.xml file, returns false (and sets the status to dirty) on failure
+  bool LoadWeightsXML( const std::string& weightsFile );
+  // fill from the forest of a generated ReadBDT class (leaf type to be set before)
+  void AddTree( BDTNode* root, double boostWeight );
+  void AddForest( const std::vector<BDTNode*>& forest, const std::vector<double>& boostWeights );
+  void SetLeafType( int type ) { fLeafType = type; }
+  void Clear();
+
+  // compare the variable names with the ones of the training (sets the status to dirty on mismatch)
+  bool CheckInputVariables( const std::vector<std::string>& theInputVars );
+
+  // classifier response for one candidate
+  virtual double GetMvaValue( const std::vector<double>& inputValues ) const;
+  double GetMvaValue( const double* inputValues ) const;
+  // classifier response for nCand candidates stored row-major (nCand x nVar)
+  void GetMvaValues( const double* inputValues, int nCand, int nVar, double* mvaValues ) const;
+
+  size_t GetNvar() const { return fInputVars.size(); }
+  size_t GetNTrees() const { return fTreeRoot.size(); }
+  size_t GetNNodes() const { return fNodes.size(); }
+  const std::vector<std::string>& GetInputVariables() const { return fInputVars; }
+
+ private:
+  int    AddNode( int var, double value );
+  void   SetChildren( int node, int left, int right, bool cutType );
+  int    FlattenNode( BDTNode* node );
+  double Finalise( double sum ) const;
+
+  struct Node {
+    double fValue;      // cut value (internal node) or leaf value
+    int    fVar;        // variable index of the node (-1 for leaves)
+    int    fChildAbove; // node reached if the variable is above the cut
+    int    fChildBelow; // node reached otherwise
+  };
+
+  int                      fLeafType;        // leaf value used in the sum over the trees
+  std::vector<std::string> fInputVars;       // names of the training variables
+  std::vector<Node>        fNodes;           // nodes of all trees, each tree in depth first order
+  std::vector<int>         fTreeRoot;        // index of the root node of each tree
+  std::vector<double>      fTreeWeight;      // boost weight of each tree
+  double                   fNorm;            // sum of the boost weights
+};
+
+#endif
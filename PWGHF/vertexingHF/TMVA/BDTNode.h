@@ -42,6 +42,10 @@ public:
    // return the node type
    int    GetNodeType( void ) const { return fNodeType; }
    double GetResponse(void) const {return fResponse;}
+   // return the index of the variable, the cut value and the cut type used in node selection
+   int    GetSelector( void ) const { return fSelector; }
+   double GetCutValue( void ) const { return fCutValue; }
+   bool   GetCutType( void ) const { return fCutType; }
 
 private:
 
@@ -215,6 +215,10 @@ class ReadBDT_LHC19c2a_8_12_noP : public IClassifierReader
   // variables given to the constructor
   double GetMvaValue(const std::vector<double> &inputValues) const;
 
+  // access to the forest, e.g. to convert it to a BDTFlatForest (added by ALICE user)
+  const std::vector<BDTNode *> &GetForest() const { return fForest; }
+  const std::vector<double> &GetBoostWeights() const { return fBoostWeights; }
+
  private:
 
    // method-specific destructor
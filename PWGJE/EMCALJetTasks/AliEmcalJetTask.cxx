@@ -31,6 +31,11 @@
 #include <TRandom3.h>
 #include <TGrid.h>
 #include <TFile.h>
+#include <TROOT.h>
+#include "FJ_includes.h" // FASTJET_HAVE_LIMITED_THREAD_SAFETY
+#if defined(R__USE_IMT) && defined(FASTJET_HAVE_LIMITED_THREAD_SAFETY)
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <AliVCluster.h>
 #include <AliVEvent.h>
@@ -98,8 +103,16 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fEnableAliBasicParticleCompatibility(kFALSE),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fAdditionalRadii(),
+  fAdditionalJetAlgos(),
+  fAdditionalRecombSchemes(),
+  fNThreads(-1),
   fJets(0),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
+  fAdditionalJetsNames(),
+  fAdditionalJets(),
+  fAdditionalWrappers(),
+  fThreadPool(nullptr),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
 {
@@ -140,8 +153,16 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fEnableAliBasicParticleCompatibility(kFALSE),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fAdditionalRadii(),
+  fAdditionalJetAlgos(),
+  fAdditionalRecombSchemes(),
+  fNThreads(-1),
   fJets(0),
   fFastJetWrapper(name,name),
+  fAdditionalJetsNames(),
+  fAdditionalJets(),
+  fAdditionalWrappers(),
+  fThreadPool(nullptr),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
 {
@@ -152,6 +173,47 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  for (auto wrapper : fAdditionalWrappers) delete wrapper;
+#if defined(R__USE_IMT) && defined(FASTJET_HAVE_LIMITED_THREAD_SAFETY)
+  delete fThreadPool;
+#endif
+}
+
+/**
+ * Add a jet definition that is run on the same constituents as the main one.
+ * The particle and cluster containers are iterated (and the artificial tracking
+ * inefficiency applied) only once per event, and the jets of each definition are written
+ * to a separate branch, named as for a jet finder task with the same settings
+ * (see GetAdditionalJetsName()). The jet utilities are only executed for the main definition.
+ *
+ * With SetNumberOfThreads() the definitions are run concurrently on a thread pool. This
+ * requires ROOT with implicit multithreading and FastJet built with thread safety.
+ * In the serial mode all definitions use the same ghosts; in the parallel mode the ghosts
+ * are generated independently for each definition.
+ *
+ * @param r Jet radius
+ * @param algo Jet algorithm (AliJetContainer::EJetAlgo_t), -1 for the algorithm of the main definition
+ * @param reco Recombination scheme (AliJetContainer::ERecoScheme_t), -1 for the scheme of the main definition
+ */
+void AliEmcalJetTask::AddJetDefinition(Double_t r, Int_t algo, Int_t reco)
+{
+  if (IsLocked()) return;
+  fAdditionalRadii.push_back(r);
+  fAdditionalJetAlgos.push_back(algo);
+  fAdditionalRecombSchemes.push_back(reco);
+}
+
+/**
+ * Name of the jet branch of an additional jet definition.
+ * Only available after the task has been initialized; definitions whose
+ * branch name was already taken in the event are skipped.
+ * @param i Index of the additional jet collection
+ * @return Name of the jet collection, empty string if not available
+ */
+const char* AliEmcalJetTask::GetAdditionalJetsName(Int_t i) const
+{
+  if (i < 0 || i >= (Int_t)fAdditionalJetsNames.size()) return "";
+  return fAdditionalJetsNames[i].Data();
 }
 
 /**
@@ -235,11 +297,15 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  for (auto jets : fAdditionalJets) jets->Delete();
   Int_t n = FindJets();
 
   if (n == 0) return kFALSE;
 
   FillJetBranch();
+  for (UInt_t i = 0; i < fAdditionalWrappers.size(); i++) {
+    FillJetBranch(*fAdditionalWrappers[i], fAdditionalJets[i], fAdditionalWrappers[i]->GetR(), kFALSE);
+  }
 
   return kTRUE;
 }
@@ -323,11 +389,45 @@ Int_t AliEmcalJetTask::FindJets()
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
   // run jet finder
-  fFastJetWrapper.Run();
+  RunJetFinders();
 
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * This method runs the jet finding for the main and the additional jet definitions
+ * on the input vectors collected in the main FastJet wrapper.
+ */
+void AliEmcalJetTask::RunJetFinders()
+{
+  if (fAdditionalWrappers.empty()) {
+    fFastJetWrapper.Run();
+    return;
+  }
+
+  for (auto wrapper : fAdditionalWrappers) {
+    wrapper->Clear();
+    wrapper->AddInputVectors(fFastJetWrapper.GetInputVectors());
+  }
+
+#if defined(R__USE_IMT) && defined(FASTJET_HAVE_LIMITED_THREAD_SAFETY)
+  if (fThreadPool) {
+    std::vector<AliFJWrapper*> wrappers(1, &fFastJetWrapper);
+    wrappers.insert(wrappers.end(), fAdditionalWrappers.begin(), fAdditionalWrappers.end());
+    fThreadPool->Foreach([](AliFJWrapper* wrapper) { wrapper->Run(); }, wrappers);
+    return;
+  }
+#endif
+
+  // All definitions are run with the ghosts of the main one. Since each of them draws
+  // the same random numbers, the random generator ends up in the same state as with a single definition.
+  fFastJetWrapper.Run();
+  for (auto wrapper : fAdditionalWrappers) {
+    wrapper->SetGhostRandomStatus(fFastJetWrapper.GetGhostRandomStatus());
+    wrapper->Run();
+  }
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -337,8 +437,22 @@ void AliEmcalJetTask::FillJetBranch()
 {
   PrepareUtilities();
 
+  FillJetBranch(fFastJetWrapper, fJets, fRadius, kTRUE);
+
+  TerminateUtilities();
+}
+
+/**
+ * This method fills a jet output branch (TClonesArray) with the jets found by a FastJet wrapper.
+ * @param wrapper FastJet wrapper that was used for the jet finding
+ * @param jets Output jet branch
+ * @param radius Jet radius (used for the jet acceptance)
+ * @param executeUtilities If true the utilities are executed for each jet
+ */
+void AliEmcalJetTask::FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t radius, Bool_t executeUtilities)
+{
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  std::vector<fastjet::PseudoJet> jets_incl = wrapper.GetInclusiveJets();
   // sort jets according to jet pt
   static Int_t indexes[9999] = {-1};
   GetSortedArray(indexes, jets_incl);
@@ -346,27 +460,27 @@ void AliEmcalJetTask::FillJetBranch()
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
     Int_t ij = indexes[ijet];
-    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
+    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), wrapper.GetJetArea(ij)));
 
     if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
+    if (wrapper.GetJetArea(ij) < fMinJetArea) continue;
     if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
 
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
+    AliEmcalJet *jet = new ((*jets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
+    fastjet::PseudoJet area(wrapper.GetJetAreaVector(ij));
     jet->SetArea(area.perp());
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), radius));
 
     // Fill constituent info
-    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
+    std::vector<fastjet::PseudoJet> constituents(wrapper.GetJetConstituents(ij));
     FillJetConstituents(jet, constituents, constituents);
 
     if (fGeom) {
@@ -377,13 +491,11 @@ void AliEmcalJetTask::FillJetBranch()
         jet->SetAxisInEmcal(kTRUE);
     }
 
-    ExecuteUtilities(jet, ij);
+    if (executeUtilities) ExecuteUtilities(jet, ij);
 
     AliDebug(2,Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
     jetCount++;
   }
-
-  TerminateUtilities();
 }
 
 /**
@@ -467,6 +579,7 @@ void AliEmcalJetTask::ExecOnce()
   fFastJetWrapper.SetAlgorithm(ConvertToFJAlgo(fJetAlgo));
   fFastJetWrapper.SetRecombScheme(ConvertToFJRecoScheme(fRecombScheme));
   fFastJetWrapper.SetMaxRap(1);
+  fFastJetWrapper.SetReuseDefinitions(kTRUE);
  
 
   // setting legacy mode
@@ -474,6 +587,44 @@ void AliEmcalJetTask::ExecOnce()
     fFastJetWrapper.SetLegacyMode(kTRUE);
   }
 
+  // additional jet definitions, run on the same input vectors
+  for (UInt_t i = 0; i < fAdditionalRadii.size(); i++) {
+    EJetAlgo_t algo = fAdditionalJetAlgos[i] < 0 ? fJetAlgo : static_cast<EJetAlgo_t>(fAdditionalJetAlgos[i]);
+    ERecoScheme_t reco = fAdditionalRecombSchemes[i] < 0 ? fRecombScheme : static_cast<ERecoScheme_t>(fAdditionalRecombSchemes[i]);
+    TString jetsName = AliJetContainer::GenerateJetName(fJetType, algo, reco, fAdditionalRadii[i], GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+    if (InputEvent()->FindListObject(jetsName)) {
+      AliError(Form("%s: Object with name %s already in event! Skipping this jet definition", GetName(), jetsName.Data()));
+      continue;
+    }
+    TClonesArray *jets = new TClonesArray("AliEmcalJet");
+    jets->SetName(jetsName);
+    ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jetsName.Data());
+    InputEvent()->AddObject(jets);
+
+    AliFJWrapper *wrapper = new AliFJWrapper(jetsName, jetsName);
+    wrapper->CopySettingsFrom(fFastJetWrapper);
+    wrapper->SetR(fAdditionalRadii[i]);
+    wrapper->SetAlgorithm(ConvertToFJAlgo(algo));
+    wrapper->SetRecombScheme(ConvertToFJRecoScheme(reco));
+    wrapper->SetReuseDefinitions(kTRUE);
+
+    fAdditionalJetsNames.push_back(jetsName);
+    fAdditionalJets.push_back(jets);
+    fAdditionalWrappers.push_back(wrapper);
+  }
+
+  // thread pool for the jet finding with several definitions
+  if (fNThreads >= 0 && !fAdditionalWrappers.empty()) {
+#if defined(R__USE_IMT) && defined(FASTJET_HAVE_LIMITED_THREAD_SAFETY)
+    // own pool, the process-wide implicit multithreading of the other wagons is left untouched
+    if (!fThreadPool) fThreadPool = new ROOT::TThreadExecutor(fNThreads);
+    AliInfo(Form("%s: %d jet definitions are run with %d threads (0 = all cores)", GetName(), (Int_t)fAdditionalWrappers.size() + 1, fNThreads));
+#else
+    AliWarning(Form("%s: ROOT without implicit multithreading or FastJet without thread safety, the jet definitions are run serially", GetName()));
+    fNThreads = -1;
+#endif
+  }
+
   InitUtilities();
 
   AliAnalysisTaskEmcal::ExecOnce();
@@ -31,6 +31,7 @@ class TClonesArray;
 class TObjArray;
 class AliVEvent;
 class AliEmcalJetUtility;
+namespace ROOT { class TThreadExecutor; }
 
 #include "TF1.h"
 #include "TRandom3.h"
@@ -71,6 +72,10 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional jet definitions (e.g. several jet radii) can be added via AddJetDefinition().
+ * The constituents are then selected once per event and all definitions are run on the same
+ * input vectors, each into its own output branch. See AddJetDefinition() for details.
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -108,6 +113,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   SetNumberOfThreads(Int_t n)                { if (IsLocked()) return; fNThreads         = n     ; }
+
+  void                   AddJetDefinition(Double_t r, Int_t algo = -1, Int_t reco = -1);
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -136,6 +144,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
+  Int_t                  GetNumberOfAdditionalJetDefinitions() const { return fAdditionalRadii.size(); }
+  const char*            GetAdditionalJetsName(Int_t i) const;
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
 
   void                   FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
@@ -183,7 +193,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  protected:
 
   Int_t                  FindJets();
+  void                   RunJetFinders();
   void                   FillJetBranch();
+  void                   FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t radius, Bool_t executeUtilities);
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
@@ -227,9 +239,17 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fEnableAliBasicParticleCompatibility; ///< Flag to allow compatibility with AliBasicParticle constituents
   Bool_t                 fLegacyMode;             //!<!=true to enable FJ 2.x behavior
   Bool_t                 fFillGhost;              ///< =true ghost particles will be filled in AliEmcalJet obj
+  std::vector<Double_t>  fAdditionalRadii;        ///< radii of the additional jet definitions
+  std::vector<Int_t>     fAdditionalJetAlgos;     ///< jet algorithms of the additional jet definitions (-1 = same as fJetAlgo)
+  std::vector<Int_t>     fAdditionalRecombSchemes;///< recombination schemes of the additional jet definitions (-1 = same as fRecombScheme)
+  Int_t                  fNThreads;               ///< threads for the jet finding with additional definitions (0 = all cores, -1 = serial)
 
   TClonesArray          *fJets;                   //!<!jet collection
   AliFJWrapper           fFastJetWrapper;         //!<!fastjet wrapper
+  std::vector<TString>   fAdditionalJetsNames;    //!<!names of the additional jet collections
+  std::vector<TClonesArray*> fAdditionalJets;     //!<!additional jet collections
+  std::vector<AliFJWrapper*> fAdditionalWrappers; //!<!fastjet wrappers of the additional jet definitions
+  ROOT::TThreadExecutor *fThreadPool;             //!<!thread pool for the jet finding with additional definitions
 
   static const Int_t     fgkConstIndexShift;      //!<!contituent index shift
 
@@ -244,7 +264,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 30);
+  ClassDef(AliEmcalJetTask, 31);
   /// \endcond
 };
 #endif
@@ -23,6 +23,8 @@ class AliFJWrapper
   virtual const char *ClassName()                            const { return "AliFJWrapper";              }
   virtual void  Clear(const Option_t* /*opt*/ = "");
   virtual void  ClearMemory();
+  virtual void  ClearDefinitions();
+  virtual void  ClearEventMemory();
   virtual void  CopySettingsFrom (const AliFJWrapper& wrapper);
   virtual void  GetMedianAndSigma(Double_t& median, Double_t& sigma, Int_t remove = 0) const;
   fastjet::ClusterSequenceArea*           GetClusterSequence() const   { return fClustSeq;                 }
@@ -50,6 +52,8 @@ class AliFJWrapper
   virtual std::vector<double>             GetSubtractedJetsPts(Double_t median_pt = -1, Bool_t sorted = kFALSE);
   Bool_t                                  GetLegacyMode()            { return fLegacyMode; }
   Bool_t                                  GetDoFilterArea()          { return fDoFilterArea; }
+  Double_t                                GetR()               const { return fR;                          }
+  const std::vector<int>&                 GetGhostRandomStatus() const { return fGhostRandomStatus;        }
   Double_t                                NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
   Double32_t                              NSubjettinessDerivativeSub(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Double_t JetR, fastjet::PseudoJet jet, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
 #ifdef FASTJET_VERSION
@@ -143,6 +147,8 @@ class AliFJWrapper
   void SetEventSub(Bool_t b) {fEventSub = b;}
   void SetMaxDelR(Double_t r)  {fMaxDelR = r;}
   void SetAlpha(Double_t a)  {fAlpha = a;}
+  void SetReuseDefinitions(Bool_t b) { fReuseDefinitions = b; }
+  void SetGhostRandomStatus(const std::vector<int>& status) { fNextGhostRandomStatus = status; }
 
 
  protected:
@@ -236,8 +242,13 @@ class AliFJWrapper
   std::vector<double>                      fGRDenominator;    //!
   std::vector<double>                      fGRNumeratorSub;   //!
   std::vector<double>                      fGRDenominatorSub; //!
+  Bool_t                                   fReuseDefinitions;      //! keep the jet and area definitions between events
+  std::vector<int>                         fGhostRandomStatus;     //! status of the ghost random generator before the last Run()
+  std::vector<int>                         fNextGhostRandomStatus; //! status of the ghost random generator to be restored in the next Run()
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
+  virtual void   InitDefinitions();
+  Bool_t         AreDefinitionsValid() const;
 
  private:
   AliFJWrapper();
@@ -340,6 +351,9 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fGRDenominator()
   , fGRNumeratorSub()
   , fGRDenominatorSub()
+  , fReuseDefinitions(false)
+  , fGhostRandomStatus()
+  , fNextGhostRandomStatus()
 {
   // Constructor.
 }
@@ -355,12 +369,26 @@ AliFJWrapper::~AliFJWrapper()
 void AliFJWrapper::ClearMemory()
 {
   // Destructor.
+  ClearDefinitions();
+  ClearEventMemory();
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::ClearDefinitions()
+{
+  // Delete the jet and area definitions.
   if (fAreaDef)           { delete fAreaDef;           fAreaDef         = NULL; }
   if (fVorAreaSpec)       { delete fVorAreaSpec;       fVorAreaSpec     = NULL; }
   if (fGhostedAreaSpec)   { delete fGhostedAreaSpec;   fGhostedAreaSpec = NULL; }
   if (fJetDef)            { delete fJetDef;            fJetDef          = NULL; }
   if (fPlugin)            { delete fPlugin;            fPlugin          = NULL; }
   if (fRange)             { delete fRange;             fRange           = NULL; }
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::ClearEventMemory()
+{
+  // Delete the cluster sequences and the objects built from them.
   if (fClustSeq)          { delete fClustSeq;          fClustSeq        = NULL; }
   if (fClustSeqES)          { delete fClustSeqES;        fClustSeqES        = NULL; }
   if (fClustSeqSA)        { delete fClustSeqSA;        fClustSeqSA        = NULL; }
@@ -413,8 +441,13 @@ void AliFJWrapper::Clear(const Option_t */*opt*/)
   fInputGhosts.clear();
   fMedUsedForBgSub = 0;
 
-  // for the moment brute force delete everything
-  ClearMemory();
+  // for the moment brute force delete everything,
+  // except for the definitions if they are reused
+  if (fReuseDefinitions) {
+    ClearEventMemory();
+  } else {
+    ClearMemory();
+  }
 }
 
 //_________________________________________________________________________________________________
@@ -693,9 +726,9 @@ void AliFJWrapper::GetMedianAndSigma(Double_t &median, Double_t &sigma, Int_t re
 }
 
 //_________________________________________________________________________________________________
-Int_t AliFJWrapper::Run()
+void AliFJWrapper::InitDefinitions()
 {
-  // Run the actual jet finder.
+  // Create the area, range and jet definitions from the current settings.
 
   if (fAreaType == fj::voronoi_area) {
     // Rfact - check dependence - default is 1.
@@ -745,6 +778,50 @@ Int_t AliFJWrapper::Run()
   } else {
     fJetDef = new fj::JetDefinition(fAlgor, fR, fScheme, fStrategy);
   }
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliFJWrapper::AreDefinitionsValid() const
+{
+  // Check whether the definitions created in a previous event still correspond to the settings.
+  // Filter() and NSubjettiness() replace fJetDef, the check on the jet definition catches it.
+
+  if (!fJetDef || !fAreaDef || !fRange) return kFALSE;
+  // plugins and the Voronoi area are always recreated
+  if (fAlgor == fj::plugin_algorithm || fAreaType == fj::voronoi_area || !fGhostedAreaSpec) return kFALSE;
+
+  if (fJetDef->jet_algorithm() != fAlgor || fJetDef->R() != fR ||
+      fJetDef->recombination_scheme() != fScheme || fJetDef->strategy() != fStrategy) return kFALSE;
+  if (fAreaDef->area_type() != fAreaType) return kFALSE;
+  if (fGhostedAreaSpec->ghost_maxrap() != fMaxRap || fGhostedAreaSpec->repeat() != fNGhostRepeats ||
+      fGhostedAreaSpec->ghost_area() != fGhostArea || fGhostedAreaSpec->grid_scatter() != fGridScatter ||
+      fGhostedAreaSpec->pt_scatter() != fKtScatter || fGhostedAreaSpec->mean_ghost_pt() != fMeanGhostKt) return kFALSE;
+
+  return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::Run()
+{
+  // Run the actual jet finder.
+  // The definitions are kept from the previous event if requested and still valid.
+
+  if (!fReuseDefinitions) {
+    InitDefinitions();
+  } else if (!AreDefinitionsValid()) {
+    ClearDefinitions();
+    InitDefinitions();
+  }
+
+  // The ghosts are generated from the status of the random generator,
+  // restoring a status repeats the ghosts of another jet finding on the same event
+  if (fGhostedAreaSpec) {
+    if (!fNextGhostRandomStatus.empty()) {
+      fGhostedAreaSpec->set_random_status(fNextGhostRandomStatus);
+      fNextGhostRandomStatus.clear();
+    }
+    fGhostedAreaSpec->get_random_status(fGhostRandomStatus);
+  }
 
   try {
     fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
@@ -60,12 +60,18 @@ AliFMDDensityCalculator::AliFMDDensityCalculator()
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fIpZBinWidth(0),
+    fIpXYBinWidth(0),
+    fMaxIpBins(64),
+    fGeometry(),
+    fNextGeometry(0)
 {
   // 
   // Constructor 
   //
   DGUARD(fDebug, 3, "Default CTOR of FMD density calculator");
+  fGeometry.SetOwner();
 }
 
 //____________________________________________________________________
@@ -98,7 +104,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fIpZBinWidth(0),
+    fIpXYBinWidth(0),
+    fMaxIpBins(64),
+    fGeometry(),
+    fNextGeometry(0)
 {
   // 
   // Constructor 
@@ -109,6 +120,7 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
   DGUARD(fDebug, 3, "Named CTOR of FMD density calculator: %s", title);
   fRingHistos.SetName(GetName());
   fRingHistos.SetOwner();
+  fGeometry.SetOwner();
   fSumOfWeights = new TH1D("sumOfWeights", "Sum of Landau weights",
 			   200, 0, 20);
   fSumOfWeights->SetFillColor(kRed+1);
@@ -167,7 +179,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
     fDoTiming(o.fDoTiming),
     fHTiming(o.fHTiming), 
   fMaxOutliers(o.fMaxOutliers),
-  fOutlierCut(o.fOutlierCut)
+  fOutlierCut(o.fOutlierCut),
+  fIpZBinWidth(o.fIpZBinWidth),
+  fIpXYBinWidth(o.fIpXYBinWidth),
+  fMaxIpBins(o.fMaxIpBins),
+  fGeometry(),
+  fNextGeometry(0)
 {
   // 
   // Copy constructor 
@@ -176,6 +193,7 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
   //    o Object to copy from 
   //
   DGUARD(fDebug, 3, "Copy CTOR of FMD density calculator");
+  fGeometry.SetOwner();
   TIter    next(&o.fRingHistos);
   TObject* obj = 0;
   while ((obj = next())) fRingHistos.Add(obj);
@@ -232,6 +250,13 @@ AliFMDDensityCalculator::operator=(const AliFMDDensityCalculator& o)
   fHTiming            = o.fHTiming;
   fMaxOutliers        = o.fMaxOutliers;
   fOutlierCut         = o.fOutlierCut;
+  fIpZBinWidth        = o.fIpZBinWidth;
+  fIpXYBinWidth       = o.fIpXYBinWidth;
+  fMaxIpBins          = o.fMaxIpBins;
+
+  // The strip geometry cache is rebuilt on demand - do not share it 
+  fGeometry.Delete();
+  fNextGeometry       = 0;
 
   fRingHistos.Delete();
   TIter    next(&o.fRingHistos);
@@ -251,6 +276,12 @@ AliFMDDensityCalculator::SetupForData(const TAxis& axis)
   //   etaAxis   Eta axis
   DGUARD(fDebug, 1, "Initialize FMD density calculator");
   CacheMaxWeights(axis);
+  // Cached strip geometries hold cuts from the previous set-up 
+  fGeometry.Delete();
+  if (fRecalculatePhi && fIpZBinWidth > 0 && fIpXYBinWidth <= 0) 
+    AliWarningF("IP z binning (%f cm) without x,y binning would drop the "
+		"(x,y) correction of the re-calculated eta,phi - geometry "
+		"cache disabled", fIpZBinWidth);
  
   fCache.Init(axis);
 
@@ -343,6 +374,95 @@ AliFMDDensityCalculator::GetMultCut(UShort_t d, Char_t r, Double_t eta,
   // return fCuts.GetMultCut(d,r,eta,errors);
 }
 
+//____________________________________________________________________
+AliFMDDensityCalculator::StripGeometry::StripGeometry(Long64_t key)
+  : TObject(),
+    fKey(key),
+    fEta(5*20*512),
+    fPhi(5*20*512),
+    fCut(5*20*512)
+{
+  // 
+  // Constructor 
+  // 
+  // Parameters:
+  //    key Interaction point bin key 
+  //
+}
+
+//____________________________________________________________________
+const AliFMDDensityCalculator::StripGeometry*
+AliFMDDensityCalculator::GetStripGeometry(const TVector3& ip)
+{
+  // 
+  // Get the strip geometry of the interaction point bin of ip.  The
+  // geometry of a new bin is calculated at the bin centre, replacing
+  // the oldest cached bin if the cache is full.
+  // 
+  // Parameters:
+  //    ip Coordinates of interaction point
+  // 
+  // Return:
+  //    Strip geometry 
+  //
+  const Int_t kOff  = 1 << 20; // Offset of bin numbers in key 
+  const Int_t kNoXY = -kOff;   // Bin number for unknown/ignored x,y 
+  Bool_t  useXY = (fIpXYBinWidth > 0 && ip.X() < 100 && ip.Y() < 100);
+  Int_t   iz    = TMath::FloorNint(ip.Z() / fIpZBinWidth);
+  Int_t   ix    = useXY ? TMath::FloorNint(ip.X() / fIpXYBinWidth) : kNoXY;
+  Int_t   iy    = useXY ? TMath::FloorNint(ip.Y() / fIpXYBinWidth) : kNoXY;
+  Long64_t key  = ((Long64_t(iz + kOff) << 42) | 
+		   (Long64_t(ix + kOff) << 21) | 
+		   Long64_t(iy + kOff));
+
+  for (Int_t i = 0; i < fGeometry.GetEntriesFast(); i++) { 
+    StripGeometry* g = static_cast<StripGeometry*>(fGeometry.At(i));
+    if (g && g->fKey == key) return g;
+  }
+
+  TVector3 centre(useXY ? (ix + .5) * fIpXYBinWidth : 1024, 
+		  useXY ? (iy + .5) * fIpXYBinWidth : 1024, 
+		  (iz + .5) * fIpZBinWidth);
+  DMSG(fDebug, 1, "Caching strip geometry for IP(x,y,z)=%f,%f,%f", 
+       centre.X(), centre.Y(), centre.Z());
+  StripGeometry* g = new StripGeometry(key);
+  Int_t          o = 0;
+  for (UShort_t d=1; d<=3; d++) { 
+    UShort_t nr = (d == 1 ? 1 : 2);
+    for (UShort_t q=0; q<nr; q++) { 
+      Char_t      r = (q == 0 ? 'I' : 'O');
+      UShort_t    ns= (q == 0 ?  20 :  40);
+      UShort_t    nt= (q == 0 ? 512 : 256);
+      for (UShort_t s=0; s<ns; s++) { 
+	for (UShort_t t=0; t<nt; t++) {
+	  Int_t    i   = o + s*nt + t;
+	  Double_t eta = 0;
+	  Double_t phi = 0;
+	  if (!AliForwardUtil::GetEtaPhi(d,r,s,t,centre,eta,phi) ||
+	      TMath::Abs(eta) < 1) {
+	    // Flag to use the ESD values (with a warning) in Calculate 
+	    g->fEta[i] = AliForwardUtil::kInvalidValue;
+	    continue;
+	  }
+	  g->fEta[i] = eta;
+	  g->fPhi[i] = phi;
+	  g->fCut[i] = GetMultCut(d, r, eta, false);
+	} // for t 
+      } // for s
+      o += ns * nt;
+    } // for q
+  } // for d
+
+  if (fGeometry.GetEntriesFast() < fMaxIpBins) fGeometry.Add(g);
+  else { 
+    if (fNextGeometry >= fGeometry.GetEntriesFast()) fNextGeometry = 0;
+    delete fGeometry.At(fNextGeometry);
+    fGeometry.AddAt(g, fNextGeometry);
+    fNextGeometry++;
+  }
+  return g;
+}
+
 #ifndef NO_TIMING
 # define START_TIMER(T) if (fDoTiming) T.Start(true)
 # define GET_TIMER(T,V) if (fDoTiming) V = T.CpuTime()
@@ -396,6 +516,15 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
   //                       TMath::Power(ip.Y(),2));
   START_TIMER(totalT);
   
+  // Cached strip geometry for this interaction point, if enabled 
+  const StripGeometry* geom = 0;
+  if (fRecalculatePhi && fIpZBinWidth > 0 && fIpXYBinWidth > 0) { 
+    START_TIMER(timer);
+    geom = GetStripGeometry(ip);
+    ADD_TIMER(timer,rePhiTime);
+  }
+  Int_t geomOff = 0; // Offset of current ring in geometry cache
+
   Double_t etaCache[20*512]; // Same number of strips per ring 
   Double_t phiCache[20*512]; // whether it is inner our outer. 
   // We do not use TArrayD because we do not wont a bounds check 
@@ -411,6 +540,7 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       UShort_t    nt= (q == 0 ? 512 : 256);
       TH2D*       h = hists.Get(d,r);
       RingHistos* rh= GetRingHistos(d,r);
+      geomOff       = (d == 1 ? 0 : 2*d - 3 + q) * 20*512;
       if (!rh) { 
 	AliError(Form("No ring histogram found for FMD%d%c", d, r));
 	fRingHistos.ls();
@@ -439,8 +569,23 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	  Double_t eta    = fmd.Eta(d,r,s,t);
 	  Double_t oldPhi = phi;
 	  Double_t oldEta = eta;
+	  Double_t cut    = 1024;
+	  Bool_t   hasCut = false;
 	  START_TIMER(timer);
-	  if (fRecalculatePhi) {
+	  if (geom) { 
+	    Int_t i = geomOff + s*nt + t;
+	    if (geom->fEta[i] == AliForwardUtil::kInvalidValue) 
+	      AliWarningF("FMD%d%c[%2d,%3d] (%f,%f,%f) invalid cached "
+			  "eta (%f)", d, r, s, t, ip.X(), ip.Y(), ip.Z(),
+			  oldEta);
+	    else { 
+	      eta    = geom->fEta[i];
+	      phi    = geom->fPhi[i];
+	      cut    = geom->fCut[i];
+	      hasCut = true;
+	    }
+	  }
+	  else if (fRecalculatePhi) {
 	    // Correct for (x,y) off set of the interaction point 
 	    // AliForwardUtil::GetEtaPhiFromStrip(r,t,eta,phi,ip.X(),ip.Y());
 	    if (!AliForwardUtil::GetEtaPhi(d,r,s,t,ip,eta,phi) ||
@@ -488,10 +633,11 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	    mult *= AcceptanceCorrection(r,t);
 
 	  // --- Get the low multiplicity cut ------------------------
-	  Double_t cut  = 1024;
-	  if (eta != AliESDFMD::kInvalidEta) cut = GetMultCut(d, r, eta,false);
-	  else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
-			   d, r, s, t, eta);
+	  if (!hasCut && eta != AliESDFMD::kInvalidEta)
+	    cut = GetMultCut(d, r, eta,false);
+	  else if (!hasCut)
+	    AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
+			d, r, s, t, eta);
 
 	  // --- Now caluculate Nch for this strip using fits --------
 	  START_TIMER(timer);
@@ -1117,6 +1263,8 @@ AliFMDDensityCalculator::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("etaLumping",   fEtaLumping));
   d->Add(AliForwardUtil::MakeParameter("phiLumping",   fPhiLumping));
   d->Add(AliForwardUtil::MakeParameter("recalcPhi",    fRecalculatePhi));
+  d->Add(AliForwardUtil::MakeParameter("ipZBinWidth",  fIpZBinWidth));
+  d->Add(AliForwardUtil::MakeParameter("ipXYBinWidth", fIpXYBinWidth));
   d->Add(AliForwardUtil::MakeParameter("maxOutliers",  fMaxOutliers));
   d->Add(AliForwardUtil::MakeParameter("outlierCut",   fOutlierCut));
   d->Add(AliForwardUtil::MakeParameter("hitThreshold", fHitThreshold));
@@ -1196,6 +1344,8 @@ AliFMDDensityCalculator::Print(Option_t* option) const
   PFV("Eta lumping",		fEtaLumping);
   PFV("Phi lumping",		fPhiLumping);
   PFB("Recalculate phi",	fRecalculatePhi);
+  PFV("IP z bin (geometry)",    fIpZBinWidth);
+  PFV("IP x,y bin (geometry)",  fIpXYBinWidth);
   PFB("Use phi acceptance",     phiM);
   PFV("Min(quality)",           fMinQuality);
   PFV("Threshold(hit)",         fHitThreshold);
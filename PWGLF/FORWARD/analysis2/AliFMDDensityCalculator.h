@@ -16,6 +16,8 @@
 #include <TNamed.h>
 #include <TList.h>
 #include <TArrayI.h>
+#include <TArrayF.h>
+#include <TObjArray.h>
 #include <TVector3.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
@@ -163,6 +165,33 @@ public:
    * 
    */
   void SetRecalculatePhi(Bool_t use) { fRecalculatePhi = use; }
+  /** 
+   * Cache the re-calculated strip @f$(\eta,\varphi)@f$ (see
+   * SetRecalculatePhi) per interaction point bin instead of
+   * re-calculating them for every event.  The strip geometry of a
+   * bin is evaluated once at the bin centre.  Since the point of
+   * re-calculating is the @f$(x,y)@f$ offset of the interaction
+   * point, the cache is only used if both @a dz and @a dxy are
+   * positive.  Events with an unknown transverse position of the
+   * interaction point use a bin evaluated with respect to the beam
+   * axis.
+   *
+   * Each cached bin holds @f$\eta@f$, @f$\varphi@f$ and the cut of
+   * all 51200 strips, i.e., about 600 KB.  The default of at most 64
+   * bins thus takes up to about 39 MB.  Binning in @f$ x,y@f$ as well
+   * multiplies the number of bins needed to cover the IP region.
+   * 
+   * @param dz      Width of the @f$ z@f$ bins (cm), 0 disables the cache 
+   * @param dxy     Width of the @f$ x,y@f$ bins (cm) 
+   * @param maxBins Maximum number of cached bins 
+   */
+  void SetIpBinning(Double_t dz, Double_t dxy=0, UShort_t maxBins=64) 
+  { 
+    fIpZBinWidth  = dz; 
+    fIpXYBinWidth = dxy; 
+    fMaxIpBins    = (maxBins < 1 ? 1 : maxBins);
+    fGeometry.Delete();
+  }
   /** 
    * Set whether to use the phi acceptance correction. 
    * 
@@ -467,6 +496,32 @@ protected:
     TH1D*     fEtaAfter;       // Phi after re-calc
     // ClassDef(RingHistos,10);
   };
+  /** 
+   * Strip @f$(\eta,\varphi)@f$ and low cut of all FMD strips for one
+   * interaction point bin.  Never streamed.
+   */
+  struct StripGeometry : public TObject
+  {
+    /** 
+     * Constructor 
+     * 
+     * @param key Interaction point bin key 
+     */
+    StripGeometry(Long64_t key=0);
+    Long64_t fKey; // Interaction point bin key
+    TArrayF  fEta; // Strip eta, kInvalidValue if not usable 
+    TArrayF  fPhi; // Strip phi 
+    TArrayF  fCut; // Low multiplicity cut of the strip 
+  };
+  /** 
+   * Get the cached strip geometry for the interaction point @a ip,
+   * calculating it if the bin of @a ip is not cached yet.
+   * 
+   * @param ip Coordinates of interaction point
+   * 
+   * @return Strip geometry 
+   */
+  const StripGeometry* GetStripGeometry(const TVector3& ip);
   /** 
    * Get the ring histogram container 
    * 
@@ -504,8 +559,13 @@ protected:
   TProfile*              fHTiming;
   Double_t               fMaxOutliers; // Maximum ratio of outlier bins 
   Double_t               fOutlierCut;  // Maximum relative diviation 
+  Double_t               fIpZBinWidth; // IP z bin width of geometry cache
+  Double_t               fIpXYBinWidth;// IP x,y bin width of geometry cache
+  UShort_t               fMaxIpBins;   // Max number of cached IP bins
+  TObjArray              fGeometry;    //! Cached strip geometries 
+  Int_t                  fNextGeometry;//! Next cache slot to replace
 
-  ClassDef(AliFMDDensityCalculator,16); // Calculate Nch density 
+  ClassDef(AliFMDDensityCalculator,17); // Calculate Nch density 
 };
 
 #endif
@@ -23,6 +23,8 @@
 #include <TChain.h>
 #include <TTree.h>
 #include <TMath.h>
+#include <TBranch.h>
+#include <TROOT.h>
 #include "AliAnalysisTask.h"
 #include "AliAnalysisManager.h"
 #include "AliESDEvent.h"
@@ -160,6 +162,7 @@ AliAnalysisTaskAO2Dconverter::AliAnalysisTaskAO2Dconverter(const char* name)
   DefineOutput(1, TList::Class());
   for (Int_t i = 0; i < kTrees; i++) {
     fTreeStatus[i] = kTRUE;
+    fTreeCompress[i] = -1;
   }
 } // AliAnalysisTaskAO2Dconverter::AliAnalysisTaskAO2Dconverter(const char* name)
 
@@ -244,7 +247,20 @@ void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
   /// algorithm = 4 : LZ4  compression algorithm is used
   /// algorithm = 5 : ZSTD compression algorithm is used
   /// So fCompress = 409 is LZ4 algorithm level 9
+  /// The setting can be changed per tree with SetTreeCompression
 
+  // Parallel compression of the output trees, the thread pool is the one enabled by the application
+  if (fTreeImplicitMT > 0) {
+#ifdef R__USE_IMT
+    if (ROOT::IsImplicitMTEnabled())
+      AliInfo(Form("Output trees are compressed with %u threads", ROOT::GetImplicitMTPoolSize()));
+    else
+      AliWarning("Implicit multithreading is not enabled, the output trees are written serially");
+#else
+    AliWarning("ROOT was built without implicit multithreading, the output trees are written serially");
+    fTreeImplicitMT = -1;
+#endif
+  }
 
   fOutputFile = TFile::Open("AO2D.root","RECREATE", "O2 AOD", fCompress); // File to store the trees of time frames
   fOutputFile->Print();
@@ -409,6 +425,10 @@ TTree* AliAnalysisTaskAO2Dconverter::CreateTree(TreeIndex t)
   fOutputDir->cd();
   AliInfo(Form("Creating tree %s\n", TreeName[t].Data()));
   fTree[t] = new TTree(TreeName[t], TreeTitle[t]);
+#ifdef R__USE_IMT
+  // Full baskets and clusters are compressed in parallel over the branches, only override the TTree default if requested
+  if (fTreeImplicitMT >= 0) fTree[t]->SetImplicitMT(fTreeImplicitMT > 0);
+#endif
   return fTree[t];
 } // TTree* AliAnalysisTaskAO2Dconverter::CreateTree(TreeIndex t)
 
@@ -786,6 +806,7 @@ void AliAnalysisTaskAO2Dconverter::InitTF(Int_t tfId)
   }
 
   Prune(); //Removing all unwanted branches (if any)
+  SetBranchCompression();
 } // void AliAnalysisTaskAO2Dconverter::InitTF(Int_t tfId)
 
 void AliAnalysisTaskAO2Dconverter::FillEventInTF()
@@ -1581,6 +1602,17 @@ void AliAnalysisTaskAO2Dconverter::FillEventInTF()
   fOffsetV0ID += nv0_filled;
 } // void AliAnalysisTaskAO2Dconverter::FillEventInTF()
 
+void AliAnalysisTaskAO2Dconverter::SetBranchCompression()
+{
+  // The compression is a property of the branches (taken from the file at creation), override it for the selected trees
+  for (Int_t i = 0; i < kTrees; i++) {
+    if (!fTree[i] || fTreeCompress[i] < 0) continue;
+    TIter next(fTree[i]->GetListOfBranches());
+    while (TBranch* branch = (TBranch*) next())
+      branch->SetCompressionSettings(fTreeCompress[i]); // Propagated to the sub-branches
+  }
+} // void AliAnalysisTaskAO2Dconverter::SetBranchCompression()
+
 void AliAnalysisTaskAO2Dconverter::FinishTF()
 {
   // Write all trees
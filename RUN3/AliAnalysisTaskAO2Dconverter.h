@@ -43,6 +43,10 @@ public:
   virtual void SetTruncation(Bool_t trunc=kTRUE) {fTruncate = trunc;}
   virtual void SetCompression(UInt_t compress=101) {fCompress = compress; }
   virtual void SetMaxBytes(ULong_t nbytes = 100000000) {fMaxBytes = nbytes;}
+  /// Parallel compression of the output trees over their branches with ROOT implicit multithreading
+  /// The thread pool has to be enabled by the application with ROOT::EnableImplicitMT
+  /// Without this call the trees keep the TTree default, i.e. IMT is used if enabled by the application
+  virtual void SetTreeImplicitMT(Bool_t imt = kTRUE) {fTreeImplicitMT = imt ? 1 : 0;}
 
   static AliAnalysisTaskAO2Dconverter* AddTask(TString suffix = "");
   enum TreeIndex { // Index of the output trees
@@ -108,6 +112,9 @@ public:
   TTree* CreateTree(TreeIndex t);
   void EnableTree(TreeIndex t) { fTreeStatus[t] = kTRUE; };
   void DisableTree(TreeIndex t) { fTreeStatus[t] = kFALSE; };
+  /// Compression algorithm and level of one tree (100 * algorithm + level as in SetCompression), e.g. 505 for ZSTD level 5 or 401 for LZ4 level 1
+  /// A negative value uses the setting of the output file
+  void SetTreeCompression(TreeIndex t, Int_t compress) { fTreeCompress[t] = compress; };
   static const TString TreeName[kTrees];  //! Names of the TTree containers
   static const TString TreeTitle[kTrees]; //! Titles of the TTree containers
 
@@ -136,10 +143,12 @@ private:
   void InitTF(Int_t tfId);            // Initialize output subdir and trees for TF tfId
   void FillEventInTF();
   void FinishTF();
+  void SetBranchCompression();        // Apply the compression settings of the individual trees
 
   // Task configuration variables
   TString fPruneList = "";                // Names of the branches that will not be saved to output file
   Bool_t fTreeStatus[kTrees] = { kTRUE }; // Status of the trees i.e. kTRUE (enabled) or kFALSE (disabled)
+  Int_t fTreeCompress[kTrees] = { -1 };   // Compression settings of the trees, -1 for the setting of the output file
   int fNumberOfEventsPerCluster = 1000;   // Maximum basket size of the trees
 
   TaskModes fTaskMode = kStandard; // Running mode of the task. Useful to set for e.g. MC mode
@@ -484,6 +493,7 @@ private:
   Bool_t fTruncate = kFALSE;
   /// Compression algotythm and level, see TFile.cxx and RZip.cxx
   UInt_t fCompress = 101; /// This is the default level in Root (zip level 1)
+  Int_t fTreeImplicitMT = -1; /// Compress the output trees with implicit multithreading (1: on, 0: off, -1: TTree default)
   Bool_t fSkipPileup = kFALSE;       /// Skip pileup events
   Bool_t fSkipTPCPileup = kFALSE;    /// Skip TPC pileup (SetRejectTPCPileupWithITSTPCnCluCorr)
   TString fCentralityMethod = "V0M"; /// Centrality method
@@ -499,7 +509,7 @@ private:
   TFile * fOutputFile = 0x0; ///! Pointer to the output file
   TDirectory * fOutputDir = 0x0; ///! Pointer to the output Root subdirectory
   
-  ClassDef(AliAnalysisTaskAO2Dconverter, 11);
+  ClassDef(AliAnalysisTaskAO2Dconverter, 12);
 };
 
 #endif
@@ -0,0 +1,352 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* AliReadBenchmark
+ *
+ * Read-throughput benchmark for ESD, AOD, nanoAOD and AO2D input files, see the header for details.
+ */
+
+#include <fstream>
+
+#include <TChain.h>
+#include <TFile.h>
+#include <TKey.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TROOT.h>
+#include <TStopwatch.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include "AliReadBenchmark.h"
+#include "AliLog.h"
+
+ClassImp(AliReadBenchmark)
+
+AliReadBenchmark::AliReadBenchmark()
+  : TNamed()
+  , fFormat(kESD)
+  , fTreeName()
+  , fBranches()
+  , fFiles()
+  , fCacheSizes()
+  , fThreads()
+  , fMaxEntries(-1)
+  , fRepetitions(1)
+  , fPerBranch(kFALSE)
+  , fResults()
+{
+  /// default constructor
+}
+
+AliReadBenchmark::AliReadBenchmark(const char *name, EFormat format)
+  : TNamed(name, GetFormatName(format))
+  , fFormat(format)
+  , fTreeName(GetDefaultTreeName(format))
+  , fBranches()
+  , fFiles()
+  , fCacheSizes()
+  , fThreads()
+  , fMaxEntries(-1)
+  , fRepetitions(1)
+  , fPerBranch(kFALSE)
+  , fResults()
+{
+  /// constructor
+}
+
+AliReadBenchmark::~AliReadBenchmark()
+{
+  /// destructor
+}
+
+const char *AliReadBenchmark::GetFormatName(EFormat format)
+{
+  static const char *kNames[kNFormats] = { "ESD", "AOD", "nanoAOD", "AO2D" };
+  return (format >= 0 && format < kNFormats) ? kNames[format] : "unknown";
+}
+
+const char *AliReadBenchmark::GetDefaultTreeName(EFormat format)
+{
+  // nanoAODs are stored in the standard AOD tree with a reduced track class
+  static const char *kTrees[kNFormats] = { "esdTree", "aodTree", "aodTree", "O2track" };
+  return (format >= 0 && format < kNFormats) ? kTrees[format] : "";
+}
+
+Int_t AliReadBenchmark::AddFileList(const char *txtFile, Int_t nFiles)
+{
+  /// Adds the files listed in txtFile (one per line, lines starting with # are skipped), returns the number of added files
+
+  std::ifstream in(txtFile);
+  if (!in.good()) {
+    AliError(Form("Cannot open file list %s", txtFile));
+    return 0;
+  }
+  Int_t count = 0;
+  std::string line;
+  while (std::getline(in, line) && (nFiles < 0 || count < nFiles)) {
+    TString fileName(line.c_str());
+    fileName = fileName.Strip(TString::kBoth);
+    if (fileName.IsNull() || fileName.BeginsWith("#")) continue;
+    AddFile(fileName);
+    count++;
+  }
+  return count;
+}
+
+TChain *AliReadBenchmark::CreateChain() const
+{
+  /// Chain over all input files. AO2D files contain one directory per time frame with the tables in it.
+
+  TChain *chain = new TChain(fTreeName);
+  for (UInt_t i = 0; i < fFiles.size(); i++) {
+    if (fFormat != kAO2D) {
+      chain->Add(fFiles[i]);
+      continue;
+    }
+    TFile *file = TFile::Open(fFiles[i]);
+    if (!file || file->IsZombie()) {
+      AliError(Form("Skipping un-openable file: %s", fFiles[i].Data()));
+      delete file;
+      continue;
+    }
+    TIter next(file->GetListOfKeys());
+    while (TKey *key = (TKey*) next()) {
+      TString dirName = key->GetName();
+      if (dirName.BeginsWith("TF_"))
+        chain->Add(Form("%s/%s/%s", fFiles[i].Data(), dirName.Data(), fTreeName.Data()));
+    }
+    file->Close();
+    delete file;
+  }
+  if (!chain->GetListOfFiles()->GetEntries()) {
+    AliError(Form("No input for tree %s", fTreeName.Data()));
+    delete chain;
+    return 0x0;
+  }
+  return chain;
+}
+
+void AliReadBenchmark::SetThreads(Int_t nThreads) const
+{
+  /// Switches ROOT implicit multithreading (parallel reading and decompression of the branches in GetEntry)
+#ifdef R__USE_IMT
+  if (ROOT::IsImplicitMTEnabled())
+    ROOT::DisableImplicitMT();
+  if (nThreads > 0)
+    ROOT::EnableImplicitMT(nThreads);
+#else
+  if (nThreads > 0)
+    AliWarning("ROOT was built without implicit multithreading, reading with one thread");
+#endif
+}
+
+void AliReadBenchmark::ActiveBranches(std::vector<TString> &branches) const
+{
+  /// Top-level branches which are read with the configured patterns
+
+  branches.clear();
+  TChain *chain = CreateChain();
+  if (!chain) return;
+  if (chain->LoadTree(0) >= 0) {
+    if (!fBranches.IsNull()) {
+      chain->SetBranchStatus("*", 0);
+      TObjArray *patterns = fBranches.Tokenize(" ");
+      for (Int_t i = 0; i < patterns->GetEntriesFast(); i++)
+        chain->SetBranchStatus(patterns->At(i)->GetName(), 1);
+      delete patterns;
+    }
+    TIter next(chain->GetTree()->GetListOfBranches());
+    while (TBranch *branch = (TBranch*) next())
+      if (chain->GetBranchStatus(branch->GetName()))
+        branches.push_back(branch->GetName());
+  }
+  delete chain;
+}
+
+Bool_t AliReadBenchmark::Measure(Result &result, const char *branch) const
+{
+  /// Reads the chain with the settings in result. If branch is given only this top-level branch (and its sub-branches) is read.
+
+  TChain *chain = CreateChain();
+  if (!chain) return kFALSE;
+
+  if (branch) {
+    chain->SetBranchStatus("*", 0);
+    chain->SetBranchStatus(branch, 1);
+    TBranch *b = (chain->LoadTree(0) >= 0) ? chain->GetBranch(branch) : 0x0;
+    if (b && b->GetListOfBranches()->GetEntriesFast() > 0) // split object branch
+      chain->SetBranchStatus(Form("%s.*", branch), 1);
+  } else if (!fBranches.IsNull()) {
+    chain->SetBranchStatus("*", 0);
+    TObjArray *patterns = fBranches.Tokenize(" ");
+    for (Int_t i = 0; i < patterns->GetEntriesFast(); i++)
+      chain->SetBranchStatus(patterns->At(i)->GetName(), 1);
+    delete patterns;
+  }
+
+  // The cache learns the branches which are read during the first entries
+  chain->SetCacheSize(result.fCacheSize);
+#ifdef R__USE_IMT
+  chain->SetImplicitMT(result.fThreads > 0);
+#endif
+
+  const Long64_t bytesBefore = TFile::GetFileBytesRead();
+  const Int_t callsBefore = TFile::GetFileReadCalls();
+  Long64_t unzipped = 0;
+  Long64_t entry = 0;
+
+  TStopwatch timer;
+  timer.Start();
+  for (; fMaxEntries < 0 || entry < fMaxEntries; entry++) {
+    if (chain->LoadTree(entry) < 0) break;
+    Int_t nbytes = chain->GetEntry(entry);
+    if (nbytes > 0) unzipped += nbytes;
+  }
+  timer.Stop();
+
+  result.fBranch = (branch) ? branch : "";
+  result.fEntries = entry;
+  result.fRealTime = timer.RealTime();
+  result.fCpuTime = timer.CpuTime();
+  result.fBytesRead = TFile::GetFileBytesRead() - bytesBefore;
+  result.fBytesUnzipped = unzipped;
+  result.fReadCalls = TFile::GetFileReadCalls() - callsBefore;
+  result.fZipBytes = 0;
+  if (branch && chain->GetTree()) {
+    // Size in the last file of the chain, scaled to the number of entries read
+    TBranch *b = chain->GetTree()->GetBranch(branch);
+    if (b && chain->GetTree()->GetEntries() > 0)
+      result.fZipBytes = (Long64_t) (b->GetZipBytes("*") * (Double_t) entry / chain->GetTree()->GetEntries());
+  }
+
+  delete chain;
+  return kTRUE;
+}
+
+Bool_t AliReadBenchmark::Run()
+{
+  /// Measures all combinations of cache sizes and thread counts (and optionally the single branches)
+
+  if (fFiles.empty()) {
+    AliError("No input files");
+    return kFALSE;
+  }
+
+  std::vector<Long64_t> cacheSizes(fCacheSizes);
+  if (cacheSizes.empty()) cacheSizes.push_back(-1); // -1: default cache of the tree
+  std::vector<Int_t> threads(fThreads);
+  if (threads.empty()) threads.push_back(0);
+
+  std::vector<TString> branches;
+  if (fPerBranch) ActiveBranches(branches);
+
+  // Implicit multithreading of the caller, restored after the thread scan
+  Int_t callerThreads = 0;
+#ifdef R__USE_IMT
+  if (ROOT::IsImplicitMTEnabled())
+    callerThreads = ROOT::GetImplicitMTPoolSize();
+#endif
+
+  fResults.clear();
+  for (UInt_t t = 0; t < threads.size(); t++) {
+    SetThreads(threads[t]);
+    for (UInt_t c = 0; c < cacheSizes.size(); c++) {
+      for (Int_t r = 0; r < fRepetitions; r++) {
+        Result result;
+        result.fCacheSize = cacheSizes[c];
+        result.fThreads = threads[t];
+        result.fRepetition = r;
+        if (!Measure(result, 0x0)) {
+          SetThreads(callerThreads);
+          return kFALSE;
+        }
+        fResults.push_back(result);
+        AliInfo(Form("%s: cache %lld, threads %d: %lld entries in %.2f s, %.1f events/s, %.1f MB/s read, %.1f MB/s unzipped",
+                     GetName(), result.fCacheSize, result.fThreads, result.fEntries, result.fRealTime,
+                     (result.fRealTime > 0) ? result.fEntries / result.fRealTime : 0.,
+                     (result.fRealTime > 0) ? result.fBytesRead / result.fRealTime / 1e6 : 0.,
+                     (result.fRealTime > 0) ? result.fBytesUnzipped / result.fRealTime / 1e6 : 0.));
+
+        for (UInt_t b = 0; b < branches.size(); b++) {
+          Result branchResult(result);
+          if (!Measure(branchResult, branches[b])) {
+            SetThreads(callerThreads);
+            return kFALSE;
+          }
+          fResults.push_back(branchResult);
+        }
+      }
+    }
+  }
+  SetThreads(callerThreads);
+  return kTRUE;
+}
+
+Bool_t AliReadBenchmark::WriteResults(const char *fileName) const
+{
+  /// Writes the results as JSON: run description and one object per measurement
+
+  std::ofstream out(fileName);
+  if (!out.good()) {
+    AliError(Form("Cannot open %s", fileName));
+    return kFALSE;
+  }
+
+  out << "{\n";
+  out << "  \"name\": \"" << GetName() << "\",\n";
+  out << "  \"format\": \"" << GetFormatName(fFormat) << "\",\n";
+  out << "  \"tree\": \"" << fTreeName.Data() << "\",\n";
+  out << "  \"branches\": \"" << fBranches.Data() << "\",\n";
+  out << "  \"files\": " << fFiles.size() << ",\n";
+  out << "  \"host\": \"" << gSystem->HostName() << "\",\n";
+  out << "  \"root\": \"" << gROOT->GetVersion() << "\",\n";
+  out << "  \"results\": [\n";
+  for (UInt_t i = 0; i < fResults.size(); i++) {
+    const Result &r = fResults[i];
+    const Double_t time = (r.fRealTime > 0) ? r.fRealTime : 1.;
+    out << "    {\"branch\": \"" << r.fBranch.Data() << "\""
+        << ", \"cache_size\": " << r.fCacheSize
+        << ", \"threads\": " << r.fThreads
+        << ", \"repetition\": " << r.fRepetition
+        << ", \"entries\": " << r.fEntries
+        << ", \"real_time\": " << r.fRealTime
+        << ", \"cpu_time\": " << r.fCpuTime
+        << ", \"bytes_read\": " << r.fBytesRead
+        << ", \"bytes_unzipped\": " << r.fBytesUnzipped
+        << ", \"read_calls\": " << r.fReadCalls
+        << ", \"zip_bytes\": " << r.fZipBytes
+        << ", \"events_per_s\": " << r.fEntries / time
+        << ", \"mb_read_per_s\": " << r.fBytesRead / time / 1e6
+        << ", \"mb_unzipped_per_s\": " << r.fBytesUnzipped / time / 1e6
+        << "}" << ((i + 1 < fResults.size()) ? "," : "") << "\n";
+  }
+  out << "  ]\n";
+  out << "}\n";
+  return kTRUE;
+}
+
+void AliReadBenchmark::Print(Option_t *) const
+{
+  Printf("%s: %s tree %s, %lu files, branches \"%s\"", GetName(), GetFormatName(fFormat), fTreeName.Data(),
+         (unsigned long) fFiles.size(), fBranches.Data());
+  Printf("%-30s %12s %7s %10s %10s %10s %12s %12s", "branch", "cache", "threads", "entries", "time (s)", "events/s", "MB/s read", "MB/s unzip");
+  for (UInt_t i = 0; i < fResults.size(); i++) {
+    const Result &r = fResults[i];
+    const Double_t time = (r.fRealTime > 0) ? r.fRealTime : 1.;
+    Printf("%-30s %12lld %7d %10lld %10.3f %10.1f %12.2f %12.2f", (r.fBranch.IsNull()) ? "(all)" : r.fBranch.Data(),
+           r.fCacheSize, r.fThreads, r.fEntries, r.fRealTime, r.fEntries / time, r.fBytesRead / time / 1e6, r.fBytesUnzipped / time / 1e6);
+  }
+}
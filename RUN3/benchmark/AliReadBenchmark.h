@@ -0,0 +1,99 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/// \class AliReadBenchmark
+///
+/// Read-throughput benchmark for ESD, AOD, nanoAOD and AO2D input files.
+///
+/// The input trees are read entry by entry (including the deserialization of the objects) for every combination
+/// of the configured TTreeCache sizes and thread counts (ROOT implicit multithreading). For each run the
+/// events/s, the MB/s (compressed bytes read from the files and uncompressed bytes) and the number of read calls
+/// are recorded. Optionally each active top-level branch is read alone to obtain the per-branch read cost.
+/// The results are written as JSON, one object per measurement, so that they can be compared between releases.
+///
+/// Example (see runReadBenchmark.C):
+///
+///     AliReadBenchmark b("esd", AliReadBenchmark::kESD);
+///     b.AddFileList("files.txt");
+///     b.SetBranches("AliESDRun* AliESDHeader* Tracks*");
+///     b.AddCacheSize(0); b.AddCacheSize(30000000);
+///     b.AddThreads(0); b.AddThreads(4);
+///     b.Run();
+///     b.WriteResults("readbenchmark.json");
+///
+/// The page cache of the operating system is not dropped between the runs, the first repetition is therefore
+/// the only one which can be a cold read.
+
+#ifndef ALIREADBENCHMARK_H
+#define ALIREADBENCHMARK_H
+
+#include <vector>
+#include <TNamed.h>
+#include <TString.h>
+
+class TChain;
+
+class AliReadBenchmark : public TNamed {
+ public:
+  enum EFormat { kESD = 0, kAOD, kNanoAOD, kAO2D, kNFormats };
+
+  AliReadBenchmark();
+  AliReadBenchmark(const char *name, EFormat format);
+  virtual ~AliReadBenchmark();
+
+  void AddFile(const char *fileName) { fFiles.push_back(fileName); }
+  Int_t AddFileList(const char *txtFile, Int_t nFiles = -1);
+  void SetTreeName(const char *treeName) { fTreeName = treeName; }  ///< default from the format, for AO2D the table (e.g. O2track)
+  void SetBranches(const char *branches) { fBranches = branches; }  ///< space separated patterns as in TTree::SetBranchStatus, empty for all
+  void AddCacheSize(Long64_t cacheSize) { fCacheSizes.push_back(cacheSize); }
+  void AddThreads(Int_t nThreads) { fThreads.push_back(nThreads); }
+  void SetMaxEntries(Long64_t maxEntries) { fMaxEntries = maxEntries; }
+  void SetRepetitions(Int_t repetitions) { fRepetitions = repetitions; }
+  void SetPerBranch(Bool_t perBranch = kTRUE) { fPerBranch = perBranch; }
+
+  Bool_t Run();
+  Bool_t WriteResults(const char *fileName) const;
+  virtual void Print(Option_t *option = "") const;
+
+  static const char *GetFormatName(EFormat format);
+  static const char *GetDefaultTreeName(EFormat format);
+
+ protected:
+  struct Result {
+    TString fBranch;       // branch read alone, empty when all active branches are read
+    Long64_t fCacheSize;   // TTreeCache size
+    Int_t fThreads;        // number of threads (0: implicit multithreading off)
+    Int_t fRepetition;     // repetition index
+    Long64_t fEntries;     // entries read
+    Double_t fRealTime;    // wall time (s)
+    Double_t fCpuTime;     // cpu time (s)
+    Long64_t fBytesRead;   // compressed bytes read from the files
+    Long64_t fBytesUnzipped; // uncompressed bytes (sum of the GetEntry return values)
+    Int_t fReadCalls;      // number of read calls to the files
+    Long64_t fZipBytes;    // compressed size of the branch in the files (per-branch measurement only)
+  };
+
+  TChain *CreateChain() const;
+  void SetThreads(Int_t nThreads) const;
+  Bool_t Measure(Result &result, const char *branch) const;
+  void ActiveBranches(std::vector<TString> &branches) const;
+
+  EFormat fFormat;                 // input format
+  TString fTreeName;               // name of the tree (table for AO2D)
+  TString fBranches;               // branch patterns to be read, empty for all
+  std::vector<TString> fFiles;     // input files
+  std::vector<Long64_t> fCacheSizes; // TTreeCache sizes to be measured
+  std::vector<Int_t> fThreads;     // thread counts to be measured
+  Long64_t fMaxEntries;            // maximal number of entries per run (-1 all)
+  Int_t fRepetitions;              // repetitions of each configuration
+  Bool_t fPerBranch;               // measure the active top-level branches one by one
+  std::vector<Result> fResults;    //! results
+
+ private:
+  AliReadBenchmark(const AliReadBenchmark&); // not implemented
+  AliReadBenchmark& operator=(const AliReadBenchmark&); // not implemented
+
+  ClassDef(AliReadBenchmark, 1); // read-throughput benchmark
+};
+
+#endif
@@ -0,0 +1,279 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* AliReadBenchmarkData
+ *
+ * Synthetic ESD, AOD and AO2D files for the read benchmark, see the header for details.
+ */
+
+#include <TClonesArray.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TMath.h>
+#include <TRandom3.h>
+#include <TTree.h>
+
+#include "AliAODEvent.h"
+#include "AliAODHeader.h"
+#include "AliAODTrack.h"
+#include "AliAODVertex.h"
+#include "AliESDEvent.h"
+#include "AliESDVertex.h"
+#include "AliESDtrack.h"
+#include "AliLog.h"
+
+#include "AliReadBenchmarkData.h"
+
+ClassImp(AliReadBenchmarkData)
+
+namespace
+{
+  const Int_t kRunNumber = 244918;
+  const Double_t kMagneticField = 5.;
+  const Double_t kMeanPt = 0.6;  // slope of the pT spectrum (GeV/c)
+  const Double_t kMaxEta = 0.9;
+
+  TFile *OpenOutput(const char *fileName, Int_t compress)
+  {
+    TFile *file = TFile::Open(fileName, "RECREATE", "read benchmark", compress);
+    if (!file || file->IsZombie()) {
+      ::Error("AliReadBenchmarkData", "Cannot create %s", fileName);
+      delete file;
+      return 0x0;
+    }
+    return file;
+  }
+}
+
+void AliReadBenchmarkData::GenerateTrack(TRandom &random, Double_t &alpha, Double_t param[5], Double_t cov[15])
+{
+  const Double_t pt = 0.15 + random.Exp(kMeanPt);
+  const Double_t eta = random.Uniform(-kMaxEta, kMaxEta);
+  const Double_t phi = random.Uniform(0., TMath::TwoPi());
+  const Double_t charge = (random.Rndm() < 0.5) ? -1. : 1.;
+
+  // Sector frame as for reconstructed tracks
+  alpha = (TMath::FloorNint(phi / (TMath::Pi() / 9.)) + 0.5) * TMath::Pi() / 9.;
+  param[0] = random.Gaus(0., 0.01);
+  param[1] = random.Gaus(0., 0.01);
+  param[2] = TMath::Sin(phi - alpha);
+  param[3] = TMath::SinH(eta);
+  param[4] = charge / pt;
+
+  for (Int_t i = 0; i < 15; i++)
+    cov[i] = 0.;
+  const Double_t diag[5] = { 1e-4, 1e-4, 1e-6, 1e-6, 1e-4 };
+  for (Int_t i = 0, k = 0; i < 5; i++) {
+    k += i;
+    cov[k + i] = diag[i] * random.Uniform(0.5, 1.5); // diagonal of the lower triangle
+  }
+}
+
+Bool_t AliReadBenchmarkData::GenerateESD(const char *fileName, Int_t nEvents, Double_t meanTracks, UInt_t seed, Int_t compress)
+{
+  TFile *file = OpenOutput(fileName, compress);
+  if (!file) return kFALSE;
+  TRandom3 random(seed);
+
+  AliESDEvent *esd = new AliESDEvent();
+  esd->CreateStdContent();
+  TTree *tree = new TTree("esdTree", "Tree with ESD objects");
+  esd->WriteToTree(tree);
+  tree->GetUserInfo()->Add(esd);
+
+  Double_t alpha = 0., param[5], cov[15];
+  for (Int_t iev = 0; iev < nEvents; iev++) {
+    esd->Reset();
+    esd->SetRunNumber(kRunNumber);
+    esd->SetMagneticField(kMagneticField);
+
+    const Int_t nTracks = random.Poisson(meanTracks);
+    Double_t pos[3] = { random.Gaus(0., 0.01), random.Gaus(0., 0.01), random.Gaus(0., 5.) };
+    Double_t posCov[6] = { 1e-6, 0., 1e-6, 0., 0., 1e-6 };
+    AliESDVertex vertex(pos, posCov, 1., nTracks);
+    vertex.SetName("PrimaryVertex");
+    esd->SetPrimaryVertexTracks(&vertex);
+
+    for (Int_t i = 0; i < nTracks; i++) {
+      GenerateTrack(random, alpha, param, cov);
+      AliESDtrack track;
+      track.Set(0., alpha, param, cov);
+      track.SetStatus(AliESDtrack::kITSin | AliESDtrack::kITSrefit | AliESDtrack::kTPCin | AliESDtrack::kTPCrefit);
+      esd->AddTrack(&track);
+    }
+    tree->Fill();
+  }
+
+  file->cd();
+  tree->Write();
+  file->Close();
+  delete file;
+  return kTRUE;
+}
+
+Bool_t AliReadBenchmarkData::GenerateAOD(const char *fileName, Int_t nEvents, Double_t meanTracks, UInt_t seed, Int_t compress)
+{
+  TFile *file = OpenOutput(fileName, compress);
+  if (!file) return kFALSE;
+  TRandom3 random(seed);
+
+  AliAODEvent *aod = new AliAODEvent();
+  aod->CreateStdContent();
+  TTree *tree = new TTree("aodTree", "AliAOD tree");
+  aod->WriteToTree(tree);
+  tree->GetUserInfo()->Add(aod);
+
+  Double_t alpha = 0., param[5], cov[15], covTr[21];
+  for (Int_t iev = 0; iev < nEvents; iev++) {
+    const Int_t nTracks = random.Poisson(meanTracks);
+    aod->ResetStd(nTracks, 1);
+
+    AliAODHeader *header = dynamic_cast<AliAODHeader*>(aod->GetHeader());
+    if (header) {
+      header->SetRunNumber(kRunNumber);
+      header->SetMagneticField(kMagneticField);
+    }
+
+    Double_t pos[3] = { random.Gaus(0., 0.01), random.Gaus(0., 0.01), random.Gaus(0., 5.) };
+    Double_t posCov[6] = { 1e-6, 0., 1e-6, 0., 0., 1e-6 };
+    AliAODVertex *vertex = new((*aod->GetVertices())[0]) AliAODVertex(pos, posCov, 1., 0x0, -1, AliAODVertex::kPrimary);
+    vertex->SetName("PrimaryVertex");
+
+    for (Int_t i = 0; i < nTracks; i++) {
+      GenerateTrack(random, alpha, param, cov);
+      AliESDtrack esdTrack; // for the conversion to cartesian coordinates
+      esdTrack.Set(0., alpha, param, cov);
+      Double_t p[3], x[3];
+      esdTrack.GetPxPyPz(p);
+      esdTrack.GetXYZ(x);
+      esdTrack.GetCovarianceXYZPxPyPz(covTr);
+      AliAODTrack *track = new((*aod->GetTracks())[i]) AliAODTrack(i, -1, p, kTRUE, x, kFALSE, covTr, (Short_t) esdTrack.GetSign(),
+                                                                   0x3f, vertex, kTRUE, kTRUE, AliAODTrack::kPrimary, 0x300);
+      track->SetFlags(AliESDtrack::kITSin | AliESDtrack::kITSrefit | AliESDtrack::kTPCin | AliESDtrack::kTPCrefit);
+      vertex->AddDaughter(track);
+    }
+    tree->Fill();
+  }
+
+  file->cd();
+  tree->Write();
+  file->Close();
+  delete file;
+  return kTRUE;
+}
+
+Bool_t AliReadBenchmarkData::GenerateAO2D(const char *fileName, Int_t nEvents, Double_t meanTracks, UInt_t seed, Int_t compress, Int_t eventsPerTF)
+{
+  // Collision and track tables with the branch names and types of AliAnalysisTaskAO2Dconverter, one directory per time frame
+
+  if (eventsPerTF < 1) {
+    ::Error("AliReadBenchmarkData", "Invalid number of events per time frame: %d", eventsPerTF);
+    return kFALSE;
+  }
+  TFile *file = OpenOutput(fileName, compress);
+  if (!file) return kFALSE;
+  TRandom3 random(seed);
+
+  Float_t posX, posY, posZ, chi2;
+  UInt_t nContrib;
+  Int_t collisionID;
+  UChar_t trackType = 0; // global track
+  Float_t x, alphaF, y, z, snp, tgl, signed1Pt;
+  Float_t sigmaY, sigmaZ, sigmaSnp, sigmaTgl, sigma1Pt;
+  UInt_t flags;
+  UChar_t itsClusterMap;
+  Float_t tpcSignal, tofSignal, length;
+
+  Double_t alpha = 0., param[5], cov[15];
+  TTree *collisions = 0x0;
+  TTree *tracks = 0x0;
+  for (Int_t iev = 0; iev < nEvents; iev++) {
+    if (iev % eventsPerTF == 0) {
+      if (collisions) {
+        collisions->Write();
+        tracks->Write();
+        delete collisions;
+        delete tracks;
+      }
+      file->mkdir(Form("TF_%d", iev / eventsPerTF))->cd();
+      collisions = new TTree("O2collision", "Collision tree");
+      collisions->Branch("fPosX", &posX, "fPosX/F");
+      collisions->Branch("fPosY", &posY, "fPosY/F");
+      collisions->Branch("fPosZ", &posZ, "fPosZ/F");
+      collisions->Branch("fChi2", &chi2, "fChi2/F");
+      collisions->Branch("fNumContrib", &nContrib, "fNumContrib/i");
+      tracks = new TTree("O2track", "Barrel tracks");
+      tracks->Branch("fCollisionsID", &collisionID, "fCollisionsID/I");
+      tracks->Branch("fTrackType", &trackType, "fTrackType/b");
+      tracks->Branch("fX", &x, "fX/F");
+      tracks->Branch("fAlpha", &alphaF, "fAlpha/F");
+      tracks->Branch("fY", &y, "fY/F");
+      tracks->Branch("fZ", &z, "fZ/F");
+      tracks->Branch("fSnp", &snp, "fSnp/F");
+      tracks->Branch("fTgl", &tgl, "fTgl/F");
+      tracks->Branch("fSigned1Pt", &signed1Pt, "fSigned1Pt/F");
+      tracks->Branch("fSigmaY", &sigmaY, "fSigmaY/F");
+      tracks->Branch("fSigmaZ", &sigmaZ, "fSigmaZ/F");
+      tracks->Branch("fSigmaSnp", &sigmaSnp, "fSigmaSnp/F");
+      tracks->Branch("fSigmaTgl", &sigmaTgl, "fSigmaTgl/F");
+      tracks->Branch("fSigma1Pt", &sigma1Pt, "fSigma1Pt/F");
+      tracks->Branch("fFlags", &flags, "fFlags/i");
+      tracks->Branch("fITSClusterMap", &itsClusterMap, "fITSClusterMap/b");
+      tracks->Branch("fTPCSignal", &tpcSignal, "fTPCSignal/F");
+      tracks->Branch("fTOFSignal", &tofSignal, "fTOFSignal/F");
+      tracks->Branch("fLength", &length, "fLength/F");
+    }
+
+    const Int_t nTracks = random.Poisson(meanTracks);
+    posX = random.Gaus(0., 0.01);
+    posY = random.Gaus(0., 0.01);
+    posZ = random.Gaus(0., 5.);
+    chi2 = 1.;
+    nContrib = nTracks;
+    collisionID = collisions->GetEntries();
+    collisions->Fill();
+
+    for (Int_t i = 0; i < nTracks; i++) {
+      GenerateTrack(random, alpha, param, cov);
+      x = 0.;
+      alphaF = alpha;
+      y = param[0];
+      z = param[1];
+      snp = param[2];
+      tgl = param[3];
+      signed1Pt = param[4];
+      sigmaY = TMath::Sqrt(cov[0]);
+      sigmaZ = TMath::Sqrt(cov[2]);
+      sigmaSnp = TMath::Sqrt(cov[5]);
+      sigmaTgl = TMath::Sqrt(cov[9]);
+      sigma1Pt = TMath::Sqrt(cov[14]);
+      flags = 0x3;
+      itsClusterMap = 0x3f;
+      tpcSignal = random.Gaus(50., 5.);
+      tofSignal = random.Uniform(1e4, 3e4);
+      length = random.Uniform(370., 500.);
+      tracks->Fill();
+    }
+  }
+  if (collisions) {
+    collisions->Write();
+    tracks->Write();
+    delete collisions;
+    delete tracks;
+  }
+  file->Close();
+  delete file;
+  return kTRUE;
+}
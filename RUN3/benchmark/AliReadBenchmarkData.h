@@ -0,0 +1,34 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/// \class AliReadBenchmarkData
+///
+/// Generator of synthetic input files for AliReadBenchmark. The events contain a primary vertex and
+/// a Poisson distributed number of tracks with an exponential pT spectrum, flat in eta and phi, stored
+/// with the standard ESD and AOD event classes or, for AO2D, in a subset of the collision and track tables
+/// of AliAnalysisTaskAO2Dconverter. The generation is reproducible for a given seed.
+
+#ifndef ALIREADBENCHMARKDATA_H
+#define ALIREADBENCHMARKDATA_H
+
+#include <Rtypes.h>
+
+class TRandom;
+
+class AliReadBenchmarkData {
+ public:
+  static Bool_t GenerateESD(const char *fileName, Int_t nEvents, Double_t meanTracks = 500, UInt_t seed = 12345, Int_t compress = 101);
+  static Bool_t GenerateAOD(const char *fileName, Int_t nEvents, Double_t meanTracks = 500, UInt_t seed = 12345, Int_t compress = 101);
+  static Bool_t GenerateAO2D(const char *fileName, Int_t nEvents, Double_t meanTracks = 500, UInt_t seed = 12345, Int_t compress = 101, Int_t eventsPerTF = 1000);
+
+ protected:
+  /// Track at the vertex in the ESD convention: rotation angle, parameters (y, z, snp, tgl, q/pt) and covariance
+  static void GenerateTrack(TRandom &random, Double_t &alpha, Double_t param[5], Double_t cov[15]);
+
+ private:
+  AliReadBenchmarkData(); // static functions only
+
+  ClassDef(AliReadBenchmarkData, 0); // synthetic data for the read benchmark
+};
+
+#endif